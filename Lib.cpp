@@ -2,6 +2,7 @@
 #include <stdint.h>
 
 #include "domain.hpp"
+#include "impl/allocator.hpp"
 
 /**
  * @file Lib.cpp
@@ -11,13 +12,45 @@
 namespace dom
 {
 
+#if defined(DOMAIN_PROFILE)
+namespace impl
+{
+
+/* When profiling, every allocation is counted on the thread which made it. */
+struct ProfileCounter
+{
+	static void Heap()
+	{
+		HeapAllocations++;
+	}
+
+	static void MPFR()
+	{
+		MPFRAllocations++;
+	}
+};
+
+}
+#endif
+
 /**
  * @brief Initialized libdomain for high-precision numbers.
+ * @details When profiling, this also has GMP (and so MPFR) count its allocations: it must be called before any hpfloat is made.
  * @author Brian Schnepp
  */
 void Init()
 {
+#if defined(DOMAIN_PROFILE)
+	impl::CountingAllocator<impl::ProfileCounter>::Install();
+#endif
 	mpfr::mpreal::set_default_prec(128);
 }
 
-}
\ No newline at end of file
+DOMAIN_INSTANTIATE(template, float)
+DOMAIN_INSTANTIATE(template, double)
+
+}
+
+#if defined(DOMAIN_PROFILE)
+DOMAIN_REPLACE_GLOBAL_NEW(dom::impl::ProfileCounter)
+#endif
@@ -0,0 +1,236 @@
+#include <chrono>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#ifndef DOMAIN_BENCH_BENCH_HPP_
+#define DOMAIN_BENCH_BENCH_HPP_
+
+/**
+ * @file bench/bench.hpp
+ * @brief A minimal harness for timing one operation at a time, and counting what it allocates, and the options and output
+ * shared by the benchmarks which run whole searches
+ */
+
+namespace bench
+{
+
+/**
+ * @brief The number of allocations made so far, by operator new or by GMP (and so MPFR), on any thread.
+ * @details This is defined in counters.cpp, which every benchmark using Suite must be linked with. When libdomain is built with
+ * DOMAIN_PROFILE, its own counters are read instead, which only count allocations made on the calling thread.
+ */
+uint64_t AllocationCount();
+
+/**
+ * @brief Sends every allocation GMP makes through the counter. This must be called before any hpfloat is created.
+ */
+void InstallCounters();
+
+/**
+ * @brief Keeps the compiler from optimizing away a value which is otherwise unused.
+ */
+template<typename T>
+inline void Keep(const T &Val)
+{
+	asm volatile("" : : "r,m"(Val) : "memory");
+}
+
+/**
+ * @brief Runs benchmarks and prints how long each operation takes, and how many allocations it makes.
+ * @details Each benchmark is a function Body(Ops), which performs its operation Ops times. It is run with more and more
+ * operations until one run takes at least MinTime, and that run is the one reported.
+ *
+ * Benchmarks can be selected from the command line: the first argument, if given, is a substring of the names to run,
+ * and the second is MinTime in seconds.
+ * @author Brian Schnepp
+ */
+class Suite
+{
+public:
+	Suite(int argc, char **argv)
+	{
+		this->Filter = (argc > 1) ? argv[1] : "";
+		this->MinTime = (argc > 2) ? std::atof(argv[2]) : 0.25;
+		this->MinTime = (this->MinTime > 0) ? this->MinTime : 0.25;
+
+		std::cout << std::left << std::setw(48) << "benchmark" << std::right << std::setw(12) << "ops"
+			<< std::setw(16) << "ns/op" << std::setw(14) << "allocs/op" << std::endl;
+	}
+
+	template<typename Fn>
+	void Run(const std::string &Name, Fn &&Body)
+	{
+		if (Name.find(this->Filter) == std::string::npos)
+		{
+			return;
+		}
+
+		/* Once, to warm up caches and any thread_local state. */
+		Body((uint64_t)1);
+
+		uint64_t Ops = 1;
+		while (true)
+		{
+			const uint64_t Before = AllocationCount();
+			const auto Start = std::chrono::steady_clock::now();
+			Body(Ops);
+			const std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+			const uint64_t Allocs = AllocationCount() - Before;
+
+			if (Elapsed.count() >= this->MinTime)
+			{
+				std::cout << std::left << std::setw(48) << Name << std::right << std::setw(12) << Ops
+					<< std::setw(16) << std::fixed << std::setprecision(1) << (Elapsed.count() * 1e9 / Ops)
+					<< std::setw(14) << std::setprecision(2) << ((double)Allocs / Ops) << std::endl;
+				return;
+			}
+
+			/* Aim a little past MinTime, but never grow by more than 100x from a run too short to trust. */
+			double Scale = (Elapsed.count() > 0) ? (1.2 * this->MinTime / Elapsed.count()) : 100.0;
+			Scale = (Scale < 2.0) ? 2.0 : ((Scale > 100.0) ? 100.0 : Scale);
+			Ops = (uint64_t)(Ops * Scale);
+		}
+	}
+
+private:
+	std::string Filter;
+	double MinTime;
+};
+
+/**
+ * @brief The options taken by every benchmark which runs whole searches.
+ * @details A benchmark with options of its own, or other defaults, can extend this and set them in its constructor.
+ */
+typedef struct Options
+{
+	std::string Kernel = "";
+	std::string Type = "all";
+	uint64_t Threads = 0;
+	uint64_t K = 1000;
+	uint64_t Iterations = 100;
+	uint64_t Repetitions = 1;
+	int64_t Budget = 0;
+	std::string Format = "csv";
+	std::string Out = "";
+}Options;
+
+/**
+ * @brief Reads the command line into Opts. Every option takes a value.
+ * @details Options which are not in Options are given to Extra(Arg, Val), which returns whether it knew them.
+ * Prints what was wrong and returns false if an option is unknown, is missing its value, or if the format or type is invalid.
+ */
+template<typename Fn>
+bool ParseOptions(int argc, char **argv, Options &Opts, Fn &&Extra)
+{
+	for (int Index = 1; Index < argc; Index++)
+	{
+		const std::string Arg = argv[Index];
+		if (Index + 1 >= argc)
+		{
+			std::cerr << "Missing value for " << Arg << std::endl;
+			return false;
+		}
+
+		const std::string Val = argv[++Index];
+		if (Arg == "--kernel")
+		{
+			Opts.Kernel = Val;
+		}
+		else if (Arg == "--type")
+		{
+			Opts.Type = Val;
+		}
+		else if (Arg == "--threads")
+		{
+			Opts.Threads = std::strtoull(Val.c_str(), nullptr, 10);
+		}
+		else if (Arg == "--k")
+		{
+			Opts.K = std::strtoull(Val.c_str(), nullptr, 10);
+		}
+		else if (Arg == "--iterations")
+		{
+			Opts.Iterations = std::strtoull(Val.c_str(), nullptr, 10);
+		}
+		else if (Arg == "--repetitions")
+		{
+			Opts.Repetitions = std::strtoull(Val.c_str(), nullptr, 10);
+		}
+		else if (Arg == "--budget")
+		{
+			Opts.Budget = std::strtoll(Val.c_str(), nullptr, 10);
+		}
+		else if (Arg == "--format")
+		{
+			Opts.Format = Val;
+		}
+		else if (Arg == "--out")
+		{
+			Opts.Out = Val;
+		}
+		else if (!Extra(Arg, Val))
+		{
+			std::cerr << "Unknown option " << Arg << std::endl;
+			return false;
+		}
+	}
+
+	if (Opts.Format != "csv" && Opts.Format != "json")
+	{
+		std::cerr << "The format must be csv or json" << std::endl;
+		return false;
+	}
+	if (Opts.Type != "float" && Opts.Type != "double" && Opts.Type != "all")
+	{
+		std::cerr << "The type must be float, double, or all" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+inline bool ParseOptions(int argc, char **argv, Options &Opts)
+{
+	return ParseOptions(argc, argv, Opts, [](const std::string &Arg, const std::string &Val) { return false; });
+}
+
+/**
+ * @brief Writes Records to the file Opts.Out, or to standard output if it is empty, with WriteCSV(Out, Records) or
+ * WriteJSON(Out, Records) as Opts.Format asks.
+ * @details Every number is written with enough digits to read back exactly. Returns false if the file could not be opened.
+ */
+template<typename Record, typename CSVFn, typename JSONFn>
+bool WriteRecords(const Options &Opts, const std::vector<Record> &Records, CSVFn &&WriteCSV, JSONFn &&WriteJSON)
+{
+	std::ofstream File;
+	if (!Opts.Out.empty())
+	{
+		File.open(Opts.Out);
+		if (!File)
+		{
+			std::cerr << "Could not open " << Opts.Out << std::endl;
+			return false;
+		}
+	}
+
+	std::ostream &Out = Opts.Out.empty() ? std::cout : File;
+	Out << std::setprecision(std::numeric_limits<double>::max_digits10);
+	if (Opts.Format == "json")
+	{
+		WriteJSON(Out, Records);
+	}
+	else
+	{
+		WriteCSV(Out, Records);
+	}
+	return true;
+}
+
+}
+
+#endif
@@ -0,0 +1,58 @@
+#include <atomic>
+#include <cstdint>
+
+#include <domain/profile.hpp>
+#include <impl/allocator.hpp>
+
+#include "bench.hpp"
+
+/**
+ * @file bench/counters.cpp
+ * @brief Counts every allocation, through replacements for the global allocation functions and GMP's allocator
+ */
+
+namespace bench
+{
+
+#if defined(DOMAIN_PROFILE)
+/* libdomain already replaces the allocators when profiling, so its counters (of the calling thread) are read instead. */
+uint64_t AllocationCount()
+{
+	return dom::impl::HeapAllocations + dom::impl::MPFRAllocations;
+}
+
+void InstallCounters()
+{
+}
+#else
+static std::atomic<uint64_t> Allocations = 0;
+
+struct Counter
+{
+	static void Heap()
+	{
+		Allocations.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	static void MPFR()
+	{
+		Allocations.fetch_add(1, std::memory_order_relaxed);
+	}
+};
+
+uint64_t AllocationCount()
+{
+	return Allocations.load(std::memory_order_relaxed);
+}
+
+void InstallCounters()
+{
+	dom::impl::CountingAllocator<Counter>::Install();
+}
+#endif
+
+}
+
+#if !defined(DOMAIN_PROFILE)
+DOMAIN_REPLACE_GLOBAL_NEW(bench::Counter)
+#endif
@@ -0,0 +1,242 @@
+#include <span>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <thread>
+#include <iostream>
+
+#include <domain.hpp>
+#include <domain/process.hpp>
+
+#include "bench.hpp"
+
+/**
+ * @file bench/primitives.cpp
+ * @brief Microbenchmarks of the operations every search spends its time in
+ */
+
+using Conf = std::unordered_map<uint64_t, bgrt::Variable<float>>;
+using Array = std::unordered_map<uint64_t, dom::Value<float>>;
+
+static Conf MakeConf(uint64_t Count)
+{
+	Conf RetVal;
+	for (uint64_t Index = 0; Index < Count; Index++)
+	{
+		RetVal[Index] = bgrt::Variable<float>((dom::hpfloat)-1.0, (dom::hpfloat)1.0);
+	}
+	return RetVal;
+}
+
+/* Five inputs added left to right */
+static Array Sum5(Array &Arr)
+{
+	Array RetVal;
+	RetVal[0] = (((Arr[0] + Arr[1]) + Arr[2]) + Arr[3]) + Arr[4];
+	return RetVal;
+}
+
+/**
+ * @brief A job which does nothing, so an executor's cost of handing out a generation can be timed on its own.
+ */
+struct EmptyJob
+{
+	void operator()(uint64_t TID, std::span<const Conf> Batch, std::vector<dom::EvalResults> &Out) const
+	{
+		Out.assign(Batch.size(), dom::EvalResults{});
+	}
+
+	void Eval(uint64_t TID, std::span<const Conf> Batch, std::vector<dom::EvalResults> &Out, dom::PhaseProfile &/* Spent */,
+		std::chrono::steady_clock::time_point &/* Began */) const
+	{
+		(*this)(TID, Batch, Out);
+	}
+
+	void Busy(uint64_t /* TID */, uint64_t /* Count */, const dom::PhaseProfile &/* Spent */,
+		std::chrono::steady_clock::time_point /* Began */) const
+	{
+	}
+
+	void Record(uint64_t TID, std::span<const Conf> Batch, const std::vector<dom::EvalResults> &Out) const
+	{
+	}
+
+	dom::ErrorStatistics *Distribution(uint64_t TID) const
+	{
+		return nullptr;
+	}
+
+	void Forget(uint64_t TID) const
+	{
+	}
+
+	bool Stopped() const
+	{
+		return false;
+	}
+};
+
+template<typename T>
+static void ValueBenchmarks(bench::Suite &Suite, const std::string &Type)
+{
+	const dom::Value<T> A((dom::hpfloat)1.25);
+	const dom::Value<T> B((dom::hpfloat)0.3);
+
+	Suite.Run("Value<" + Type + ">::operator+", [&](uint64_t Ops)
+	{
+		for (uint64_t Op = 0; Op < Ops; Op++)
+		{
+			dom::Value<T> C = A + B;
+			bench::Keep(C);
+		}
+	});
+	Suite.Run("Value<" + Type + ">::operator*", [&](uint64_t Ops)
+	{
+		for (uint64_t Op = 0; Op < Ops; Op++)
+		{
+			dom::Value<T> C = A * B;
+			bench::Keep(C);
+		}
+	});
+	Suite.Run("Value<" + Type + ">::operator/", [&](uint64_t Ops)
+	{
+		for (uint64_t Op = 0; Op < Ops; Op++)
+		{
+			dom::Value<T> C = A / B;
+			bench::Keep(C);
+		}
+	});
+	Suite.Run("Value<" + Type + ">::operator+ (recording)", [&](uint64_t Ops)
+	{
+		dom::impl::Tape Rec;
+		dom::impl::ScopedTape Scope(Rec);
+		dom::Value<T> L(A);
+		dom::Value<T> R(B);
+		for (uint64_t Op = 0; Op < Ops; Op++)
+		{
+			/* Start over now and then, so the tape stays about the size one run of a kernel makes. */
+			if ((Op & 4095) == 0)
+			{
+				Rec.Clear();
+				L.Track();
+				R.Track();
+			}
+			dom::Value<T> C = L + R;
+			bench::Keep(C);
+		}
+	});
+	Suite.Run("Value<" + Type + ">::Value(const Value&)", [&](uint64_t Ops)
+	{
+		for (uint64_t Op = 0; Op < Ops; Op++)
+		{
+			dom::Value<T> C(A);
+			bench::Keep(C);
+		}
+	});
+	Suite.Run("Value<" + Type + ">::operator=(const Value&)", [&](uint64_t Ops)
+	{
+		dom::Value<T> C;
+		for (uint64_t Op = 0; Op < Ops; Op++)
+		{
+			C = (Op & 1) ? A : B;
+			bench::Keep(C);
+		}
+	});
+}
+
+static void StateBenchmarks(bench::Suite &Suite, uint64_t Count)
+{
+	const std::string Suffix = "/" + std::to_string(Count);
+	const Conf Init = MakeConf(Count);
+	bgrt::BGRTState<float> State(Init);
+
+	Suite.Run("BGRTState::HalfConfigs" + Suffix, [&](uint64_t Ops)
+	{
+		for (uint64_t Op = 0; Op < Ops; Op++)
+		{
+			bench::Keep(bgrt::BGRTState<float>::HalfConfigs(Init));
+		}
+	});
+	Suite.Run("BGRTState::PartConf" + Suffix, [&](uint64_t Ops)
+	{
+		for (uint64_t Op = 0; Op < Ops; Op++)
+		{
+			bench::Keep(State.PartConf());
+		}
+	});
+
+	auto Halves = bgrt::BGRTState<float>::HalfConfigs(Init);
+	Suite.Run("BGRTState::UnionConfigurations" + Suffix, [&](uint64_t Ops)
+	{
+		for (uint64_t Op = 0; Op < Ops; Op++)
+		{
+			bench::Keep(bgrt::BGRTState<float>::UnionConfigurations(Halves[0], Halves[1]));
+		}
+	});
+	Suite.Run("BGRTState::NextGen(10)" + Suffix, [&](uint64_t Ops)
+	{
+		for (uint64_t Op = 0; Op < Ops; Op++)
+		{
+			bench::Keep(State.NextGen(10));
+		}
+	});
+}
+
+template<typename Executor>
+static void HandshakeBenchmark(bench::Suite &Suite, const std::string &Name, Executor &Exec)
+{
+	std::vector<std::vector<Conf>> Parts(Exec.Workers());
+	std::vector<dom::impl::WorkerResult<float>> Results(Exec.Workers());
+	EmptyJob Job;
+	Suite.Run(Name, [&](uint64_t Ops)
+	{
+		for (uint64_t Op = 0; Op < Ops; Op++)
+		{
+			Exec.Execute(Parts, Results, Job);
+		}
+	});
+}
+
+int main(int argc, char **argv)
+{
+	bench::InstallCounters();
+	dom::Init();
+
+	bench::Suite Suite(argc, argv);
+	ValueBenchmarks<float>(Suite, "float");
+	ValueBenchmarks<double>(Suite, "double");
+
+	for (uint64_t Count : {5, 25, 125})
+	{
+		StateBenchmarks(Suite, Count);
+	}
+
+	const Conf Five = MakeConf(5);
+	for (uint64_t k : {1, 10, 100, 1000})
+	{
+		Suite.Run("Eval(k=" + std::to_string(k) + ")/5", [&](uint64_t Ops)
+		{
+			for (uint64_t Op = 0; Op < Ops; Op++)
+			{
+				bench::Keep(dom::Eval<float>(Sum5, Five, k));
+			}
+		});
+	}
+
+	/* The time from handing a generation to the workers, to hearing back from all of them. */
+	dom::SerialExecutor<float> Serial;
+	HandshakeBenchmark(Suite, "SerialExecutor::Execute", Serial);
+	std::vector<uint64_t> WorkerCounts{1};
+	if (std::thread::hardware_concurrency() > 1)
+	{
+		WorkerCounts.push_back(std::thread::hardware_concurrency());
+	}
+	for (uint64_t Workers : WorkerCounts)
+	{
+		dom::ThreadExecutor<float> Threads(Workers);
+		HandshakeBenchmark(Suite, "ThreadExecutor::Execute/" + std::to_string(Threads.Workers()), Threads);
+	}
+	dom::ProcessExecutor<float> Procs(1);
+	HandshakeBenchmark(Suite, "ProcessExecutor::Execute/1", Procs);
+	return 0;
+}
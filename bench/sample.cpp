@@ -0,0 +1,46 @@
+#include <string>
+#include <iostream>
+
+#include <domain.hpp>
+
+#include "bench.hpp"
+
+/**
+ * @file bench/sample.cpp
+ * @brief Microbenchmarks of Variable::Sample, which is built once for each way of generating random numbers
+ * (ACCURATE_RANDOM, FAIR_RANDOM, OKAY_RANDOM, and TIME_RANDOM), each linking a libdomain which samples the same way
+ */
+
+#if defined(ACCURATE_RANDOM)
+#define RANDOM_MODE "accurate"
+#elif defined(OKAY_RANDOM)
+#define RANDOM_MODE "okay"
+#elif defined(TIME_RANDOM)
+#define RANDOM_MODE "time"
+#else
+#define RANDOM_MODE "fair"
+#endif
+
+template<typename T>
+static void SampleBenchmark(bench::Suite &Suite, const std::string &Type)
+{
+	const bgrt::Variable<T> Var((dom::hpfloat)-1.0, (dom::hpfloat)1.0);
+	Suite.Run("Variable<" + Type + ">::Sample/" RANDOM_MODE, [&](uint64_t Ops)
+	{
+		for (uint64_t Op = 0; Op < Ops; Op++)
+		{
+			bench::Keep(Var.Sample());
+		}
+	});
+}
+
+int main(int argc, char **argv)
+{
+	bench::InstallCounters();
+	dom::Init();
+
+	bench::Suite Suite(argc, argv);
+	SampleBenchmark<float>(Suite, "float");
+	SampleBenchmark<double>(Suite, "double");
+	return 0;
+}
@@ -0,0 +1,237 @@
+#include <cmath>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+#include <sys/resource.h>
+
+#include <domain.hpp>
+
+#include "bench.hpp"
+#include "stencils.hpp"
+
+/**
+ * @file bench/stencil.cpp
+ * @brief Runs the stencil kernels of stencils.hpp with configurable parameters, and reports each run as CSV or JSON
+ *
+ * Usage: bench-stencils [--kernel NAME] [--type float|double|all] [--threads N] [--k K] [--iterations I]
+ *                       [--repetitions R] [--budget OPS] [--format csv|json] [--out FILE]
+ *
+ * --kernel runs only the kernels whose names contain NAME (such as "LTR" or "125pt").
+ * --budget stops every search after roughly OPS shadow operations, rather than once the search is exhausted,
+ * which is useful for comparing performance between builds in a bounded amount of time.
+ */
+
+/**
+ * @brief Everything measured by one run of one kernel.
+ */
+typedef struct RunRecord
+{
+	std::string Kernel;
+	std::string Type;
+	uint64_t Threads;
+	uint64_t K;
+	uint64_t Iterations;
+	uint64_t Repetition;
+
+	double Seconds;
+	uint64_t Generations;
+	uint64_t ShadowOps;
+	uint64_t Configurations;
+	uint64_t Samples;
+
+	double AbsErr;
+	double RelErr;
+	double ULPErr;
+	uint64_t PeakRSS;
+}RunRecord;
+
+/**
+ * @brief Forgets the peak resident set size so far, so the next run's peak can be measured on its own. Only Linux can do this.
+ */
+static void ResetPeakRSS()
+{
+#if defined(__linux__)
+	std::ofstream ClearRefs("/proc/self/clear_refs");
+	ClearRefs << "5";
+#endif
+}
+
+/**
+ * @brief The peak resident set size since the last ResetPeakRSS (or, if that isn't possible, since the process started), in KiB.
+ */
+static uint64_t PeakRSS()
+{
+#if defined(__linux__)
+	std::ifstream Status("/proc/self/status");
+	std::string Line;
+	while (std::getline(Status, Line))
+	{
+		if (Line.rfind("VmHWM:", 0) == 0)
+		{
+			return std::strtoull(Line.c_str() + 6, nullptr, 10);
+		}
+	}
+#endif
+	struct rusage Usage;
+	getrusage(RUSAGE_SELF, &Usage);
+	return (uint64_t)Usage.ru_maxrss;
+}
+
+/**
+ * @brief The error of a result in units in the last place of the correct value, in the precision searched.
+ * @details If the correct value is zero, the smallest subnormal number is used as the unit.
+ */
+template<typename T>
+static double ULPError(const dom::EvalResults &Res)
+{
+	double Unit = std::numeric_limits<T>::denorm_min();
+	if (!mpfr_zero_p(Res.CorrectValue.mpfr_srcptr()) && mpfr_number_p(Res.CorrectValue.mpfr_srcptr()))
+	{
+		/* |Correct| is in [2^(Exp-1), 2^Exp), where one unit is epsilon relative to the bottom of the binade. */
+		const int64_t Exp = mpfr_get_exp(Res.CorrectValue.mpfr_srcptr());
+		Unit = std::ldexp((double)std::numeric_limits<T>::epsilon(), (int)(Exp - 1));
+		Unit = (Unit < std::numeric_limits<T>::denorm_min()) ? std::numeric_limits<T>::denorm_min() : Unit;
+	}
+	return mpfr_get_d(Res.Err.mpfr_srcptr(), MPFR_RNDN) / Unit;
+}
+
+template<typename T, typename Engine>
+static RunRecord Measure(Engine &Search, const std::unordered_map<uint64_t, bgrt::Variable<T>> &Init)
+{
+	ResetPeakRSS();
+	const auto Start = std::chrono::steady_clock::now();
+	const dom::EvalResults Res = Search.Run(Init);
+	const std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+
+	RunRecord RetVal{};
+	RetVal.Seconds = Elapsed.count();
+	RetVal.Generations = Search.Status().Generation;
+	RetVal.ShadowOps = Search.Status().ShadowOps;
+	RetVal.Configurations = Search.Status().Evaluated;
+	RetVal.Samples = Search.Status().Samples;
+	RetVal.AbsErr = mpfr_get_d(Res.Err.mpfr_srcptr(), MPFR_RNDN);
+	RetVal.RelErr = mpfr_get_d(Res.RelErr.mpfr_srcptr(), MPFR_RNDN);
+	RetVal.ULPErr = ULPError<T>(Res);
+	RetVal.PeakRSS = PeakRSS();
+	return RetVal;
+}
+
+/**
+ * @brief Runs one kernel until the search is exhausted, or until a budget of shadow operations is spent.
+ */
+template<typename T>
+static RunRecord RunKernel(std::unordered_map<uint64_t, dom::Value<T>> (*F)(std::unordered_map<uint64_t, dom::Value<T>>&),
+	uint64_t Inputs, const bench::Options &Opts, std::ostream &LogOut)
+{
+	std::unordered_map<uint64_t, bgrt::Variable<T>> Init;
+	for (uint64_t Index = 0; Index < Inputs; Index++)
+	{
+		Init[Index] = bgrt::Variable<T>((dom::hpfloat)-1.0, (dom::hpfloat)1.0);
+	}
+
+	dom::ThreadExecutor<T> Exec(Opts.Threads);
+	RunRecord RetVal;
+	if (Opts.Budget > 0)
+	{
+		dom::SearchEngine<T, dom::ShadowOpBudget, dom::AcceptAll, dom::RandomRestart, dom::ThreadExecutor<T>> Engine(F, Exec,
+			dom::ShadowOpBudget{Opts.Budget}, dom::AcceptAll{}, dom::RandomRestart{5}, Opts.Iterations, Opts.K, 0, LogOut);
+		RetVal = Measure<T>(Engine, Init);
+	}
+	else
+	{
+		dom::SearchEngine<T, dom::FilterExhausted, dom::MantissaRangeFilter<T>, dom::RandomRestart, dom::ThreadExecutor<T>> Engine(F, Exec,
+			dom::FilterExhausted{}, dom::MantissaRangeFilter<T>(0, 1.0), dom::RandomRestart{5}, Opts.Iterations, Opts.K, 0, LogOut);
+		RetVal = Measure<T>(Engine, Init);
+	}
+	RetVal.Threads = Exec.Workers();
+	return RetVal;
+}
+
+static void WriteCSV(std::ostream &Out, const std::vector<RunRecord> &Records)
+{
+	Out << "kernel,type,threads,k,iterations,repetition,seconds,generations,shadow_ops,shadow_ops_per_s,"
+		<< "configurations,configurations_per_s,samples,abs_err,rel_err,ulp_err,peak_rss_kib" << std::endl;
+	for (const RunRecord &Rec : Records)
+	{
+		Out << Rec.Kernel << "," << Rec.Type << "," << Rec.Threads << "," << Rec.K << "," << Rec.Iterations << ","
+			<< Rec.Repetition << "," << Rec.Seconds << "," << Rec.Generations << "," << Rec.ShadowOps << ","
+			<< (Rec.ShadowOps / Rec.Seconds) << "," << Rec.Configurations << "," << (Rec.Configurations / Rec.Seconds) << ","
+			<< Rec.Samples << "," << Rec.AbsErr << "," << Rec.RelErr << "," << Rec.ULPErr << "," << Rec.PeakRSS << std::endl;
+	}
+}
+
+static void WriteJSON(std::ostream &Out, const std::vector<RunRecord> &Records)
+{
+	Out << "[" << std::endl;
+	for (uint64_t Index = 0; Index < Records.size(); Index++)
+	{
+		const RunRecord &Rec = Records[Index];
+		Out << "  {\"kernel\": \"" << Rec.Kernel << "\", \"type\": \"" << Rec.Type << "\", \"threads\": " << Rec.Threads
+			<< ", \"k\": " << Rec.K << ", \"iterations\": " << Rec.Iterations << ", \"repetition\": " << Rec.Repetition
+			<< ", \"seconds\": " << Rec.Seconds << ", \"generations\": " << Rec.Generations
+			<< ", \"shadow_ops\": " << Rec.ShadowOps << ", \"shadow_ops_per_s\": " << (Rec.ShadowOps / Rec.Seconds)
+			<< ", \"configurations\": " << Rec.Configurations << ", \"configurations_per_s\": " << (Rec.Configurations / Rec.Seconds)
+			<< ", \"samples\": " << Rec.Samples << ", \"abs_err\": " << Rec.AbsErr << ", \"rel_err\": " << Rec.RelErr
+			<< ", \"ulp_err\": " << Rec.ULPErr << ", \"peak_rss_kib\": " << Rec.PeakRSS << "}"
+			<< ((Index + 1 < Records.size()) ? "," : "") << std::endl;
+	}
+	Out << "]" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+	bench::Options Opts;
+	if (!bench::ParseOptions(argc, argv, Opts))
+	{
+		return 1;
+	}
+
+	dom::Init();
+	std::ostringstream LogOut;
+
+	std::vector<RunRecord> Records;
+	for (const bench::Kernel &Kern : bench::Kernels())
+	{
+		if (std::string(Kern.Name).find(Opts.Kernel) == std::string::npos)
+		{
+			continue;
+		}
+
+		for (uint64_t Rep = 0; Rep < Opts.Repetitions; Rep++)
+		{
+			for (const std::string Type : {"float", "double"})
+			{
+				if (Opts.Type != "all" && Opts.Type != Type)
+				{
+					continue;
+				}
+
+				RunRecord Rec = (Type == "float") ? RunKernel<float>(Kern.Float, Kern.Inputs, Opts, LogOut)
+					: RunKernel<double>(Kern.Double, Kern.Inputs, Opts, LogOut);
+				Rec.Kernel = Kern.Name;
+				Rec.Type = Type;
+				Rec.K = Opts.K;
+				Rec.Iterations = Opts.Iterations;
+				Rec.Repetition = Rep;
+				Records.push_back(Rec);
+
+				/* Nothing reads the search's own log. */
+				LogOut.str("");
+				std::cerr << Kern.Name << " (" << Type << ", run " << Rep << "): " << Rec.Seconds << " s" << std::endl;
+			}
+		}
+	}
+
+	if (!bench::WriteRecords(Opts, Records, WriteCSV, WriteJSON))
+	{
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,84 @@
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <domain.hpp>
+
+#include "../tests/kernels/ltr-5-pt.hpp"
+#include "../tests/kernels/ltr-7-pt.hpp"
+#include "../tests/kernels/ltr-9-pt.hpp"
+#include "../tests/kernels/ltr-13-pt.hpp"
+#include "../tests/kernels/ltr-25-pt.hpp"
+#include "../tests/kernels/ltr-27-pt.hpp"
+#include "../tests/kernels/ltr-125-pt.hpp"
+#include "../tests/kernels/ltr-poisson.hpp"
+#include "../tests/kernels/balanced-5-pt.hpp"
+#include "../tests/kernels/balanced-7-pt.hpp"
+#include "../tests/kernels/balanced-9-pt.hpp"
+#include "../tests/kernels/balanced-13-pt.hpp"
+#include "../tests/kernels/balanced-25-pt.hpp"
+#include "../tests/kernels/balanced-27-pt.hpp"
+#include "../tests/kernels/balanced-125-pt.hpp"
+#include "../tests/kernels/balanced-poisson.hpp"
+
+#ifndef DOMAIN_BENCH_STENCILS_HPP_
+#define DOMAIN_BENCH_STENCILS_HPP_
+
+/**
+ * @file bench/stencils.hpp
+ * @brief The stencil kernels of tests/, in both precisions, for benchmarking
+ * @details These are the same kernels the tests run (see tests/kernels/), under the same names, so their errors can be
+ * compared with results from run_scripts/ and plotting/.
+ */
+
+namespace bench
+{
+
+template<typename T>
+using Array = kernels::Array<T>;
+
+/**
+ * @brief A kernel, along with how many inputs it takes, in both precisions.
+ */
+typedef struct Kernel
+{
+	const char *Name;
+	uint64_t Inputs;
+	Array<float> (*Float)(Array<float>&);
+	Array<double> (*Double)(Array<double>&);
+}Kernel;
+
+#define BENCH_KERNEL(Name, Space) \
+	Kernel{Name, kernels::Space::Inputs, kernels::Space::Function<float>, kernels::Space::Function<double>}
+
+/**
+ * @brief Every kernel, in both orders of summation.
+ */
+inline const std::vector<Kernel> &Kernels()
+{
+	static const std::vector<Kernel> RetVal = {
+		BENCH_KERNEL("LTR 5pt", ltr5),
+		BENCH_KERNEL("LTR 7pt", ltr7),
+		BENCH_KERNEL("LTR 9pt", ltr9),
+		BENCH_KERNEL("LTR 13pt", ltr13),
+		BENCH_KERNEL("LTR 25pt", ltr25),
+		BENCH_KERNEL("LTR 27pt", ltr27),
+		BENCH_KERNEL("LTR 125pt", ltr125),
+		BENCH_KERNEL("LTR Poisson", ltrpoisson),
+		BENCH_KERNEL("Balanced 5pt", balanced5),
+		BENCH_KERNEL("Balanced 7pt", balanced7),
+		BENCH_KERNEL("Balanced 9pt", balanced9),
+		BENCH_KERNEL("Balanced 13pt", balanced13),
+		BENCH_KERNEL("Balanced 25pt", balanced25),
+		BENCH_KERNEL("Balanced 27pt", balanced27),
+		BENCH_KERNEL("Balanced 125pt", balanced125),
+		BENCH_KERNEL("Balanced Poisson", balancedpoisson),
+	};
+	return RetVal;
+}
+
+#undef BENCH_KERNEL
+
+}
+
+#endif
@@ -0,0 +1,330 @@
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <iostream>
+
+#include <unistd.h>
+
+#include <domain.hpp>
+#include <domain/process.hpp>
+
+#include "bench.hpp"
+#include "synthetic.hpp"
+
+/**
+ * @file bench/synthetic.cpp
+ * @brief Scores search strategies by how quickly they approach the known highest error of each synthetic kernel
+ *
+ * Usage: bench-synthetic [--kernel NAME] [--setting NAME] [--type float|double|all] [--threads N] [--k K]
+ *                        [--iterations I] [--restart PERCENT] [--repetitions R] [--budget OPS] [--format csv|json] [--out FILE]
+ *
+ * --kernel and --setting run only the kernels and settings whose names contain NAME.
+ * Every search stops after roughly --budget shadow operations (default 20000000), or once its ranges are too narrow to split.
+ * For each of 50%, 90%, and 99% of the highest error, the time and shadow operations the search took to first reach it
+ * are reported, or left empty (null in JSON) if it never did. These are read from a trace of the search (see
+ * include/domain/trace.hpp), as of the end of the generation which reached it.
+ */
+
+/* The fractions of the highest error to report the time to reach */
+static constexpr std::array<double, 3> Milestones = {0.5, 0.9, 0.99};
+
+/**
+ * @brief When a search first reached one of the Milestones.
+ */
+typedef struct Milestone
+{
+	bool Reached;
+	double Seconds;
+	uint64_t ShadowOps;
+	uint64_t Generation;
+}Milestone;
+
+/**
+ * @brief Everything measured by one run of one kernel under one setting.
+ */
+typedef struct RunRecord
+{
+	std::string Kernel;
+	std::string Setting;
+	std::string Type;
+	uint64_t Threads;
+	uint64_t K;
+	uint64_t Repetition;
+
+	double Seconds;
+	uint64_t Generations;
+	uint64_t ShadowOps;
+
+	double MaxErr;
+	double FoundErr;
+	std::array<Milestone, Milestones.size()> Reached;
+}RunRecord;
+
+/**
+ * @brief The options of bench::Options, and which settings to run and how often to restart, with a budget by default.
+ */
+typedef struct Options : bench::Options
+{
+	std::string Setting = "";
+	uint64_t Restart = 5;
+
+	Options()
+	{
+		this->K = 100;
+		this->Budget = 20000000;
+	}
+}Options;
+
+/**
+ * @brief How to search: which executor, splitting policy, and pruning to use.
+ */
+enum class Strategy
+{
+	Serial,
+	Threads,
+	Prune,
+	Sensitivity,
+	Credit,
+	Processes,
+};
+
+typedef struct Setting
+{
+	const char *Name;
+	Strategy How;
+}Setting;
+
+static const std::vector<Setting> Settings = {
+	{"serial", Strategy::Serial},
+	{"threads", Strategy::Threads},
+	{"threads-prune", Strategy::Prune},
+	{"threads-sensitivity", Strategy::Sensitivity},
+	{"threads-credit", Strategy::Credit},
+	{"processes", Strategy::Processes},
+};
+
+/**
+ * @brief Runs one search, recording every generation, and finds when it first reached each milestone.
+ */
+template<typename T, typename Executor, typename Split>
+static RunRecord Measure(const bench::Synthetic<T> &Kern, Executor &Exec, const Split &Guide, double PruneFactor,
+	const Options &Opts, std::ostream &LogOut)
+{
+	using Stop = dom::AnyOf<dom::ShadowOpBudget, dom::FilterExhausted>;
+
+	/* Stop splitting ranges a few ULPs wide, before sampling them can go out of bounds. */
+	dom::SearchEngine<T, Stop, dom::MantissaRangeFilter<T>, dom::RandomRestart, Executor, Split> Engine(Kern.F, Exec,
+		Stop(dom::ShadowOpBudget{Opts.Budget}, dom::FilterExhausted{}), dom::MantissaRangeFilter<T>(8, 1.0),
+		dom::RandomRestart{Opts.Restart}, Opts.Iterations, Opts.K, 0, LogOut);
+	Engine.SetSplit(Guide);
+	Engine.SetPruneFactor(PruneFactor);
+
+	/* The trace is only read back by this process, so the file can go as soon as the search is over. */
+	char Path[] = "/tmp/bench-synthetic-XXXXXX";
+	const int FD = mkstemp(Path);
+	if (FD >= 0)
+	{
+		close(FD);
+	}
+	dom::TraceRecorder Trace(Path, Exec.Workers(), 1 << 20);
+	if (Trace.Usable())
+	{
+		Engine.SetTrace(&Trace);
+	}
+
+	const auto Start = std::chrono::steady_clock::now();
+	const dom::EvalResults Res = Engine.Run(Kern.Init());
+	const std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+
+	RunRecord RetVal{};
+	RetVal.Threads = Exec.Workers();
+	RetVal.Seconds = Elapsed.count();
+	RetVal.Generations = Engine.Status().Generation;
+	RetVal.ShadowOps = Engine.Status().ShadowOps;
+	RetVal.MaxErr = mpfr_get_d(Kern.MaxError.mpfr_srcptr(), MPFR_RNDN);
+	RetVal.FoundErr = mpfr_get_d(Res.Err.mpfr_srcptr(), MPFR_RNDN);
+
+	for (const dom::TraceRecord &Rec : Trace.Records())
+	{
+		for (uint64_t Index = 0; Index < Milestones.size(); Index++)
+		{
+			Milestone &Mark = RetVal.Reached[Index];
+			if (!Mark.Reached && Rec.GlobalBest >= Milestones[Index] * RetVal.MaxErr)
+			{
+				Mark = Milestone{true, Rec.Time / 1e9, Rec.ShadowOps, Rec.Generation};
+			}
+		}
+	}
+	unlink(Path);
+	return RetVal;
+}
+
+template<typename T>
+static RunRecord RunSetting(const bench::Synthetic<T> &Kern, Strategy How, const Options &Opts, std::ostream &LogOut)
+{
+	if (How == Strategy::Serial)
+	{
+		dom::SerialExecutor<T> Exec;
+		return Measure<T>(Kern, Exec, dom::UniformSplit{}, 0.0, Opts, LogOut);
+	}
+	if (How == Strategy::Processes)
+	{
+		dom::ProcessExecutor<T> Exec(Opts.Threads);
+		return Measure<T>(Kern, Exec, dom::UniformSplit{}, 0.0, Opts, LogOut);
+	}
+
+	dom::ThreadExecutor<T> Exec(Opts.Threads);
+	if (How == Strategy::Sensitivity)
+	{
+		return Measure<T>(Kern, Exec, dom::SensitivitySplit{}, 0.0, Opts, LogOut);
+	}
+	if (How == Strategy::Credit)
+	{
+		return Measure<T>(Kern, Exec, dom::CreditSplit{}, 0.0, Opts, LogOut);
+	}
+	return Measure<T>(Kern, Exec, dom::UniformSplit{}, (How == Strategy::Prune) ? 2.0 : 0.0, Opts, LogOut);
+}
+
+template<typename T>
+static void RunAll(const std::string &Type, const Options &Opts, std::vector<RunRecord> &Records)
+{
+	std::ostringstream LogOut;
+	for (const bench::Synthetic<T> &Kern : bench::Synthetics<T>())
+	{
+		if (std::string(Kern.Name).find(Opts.Kernel) == std::string::npos)
+		{
+			continue;
+		}
+
+		for (const Setting &Set : Settings)
+		{
+			if (std::string(Set.Name).find(Opts.Setting) == std::string::npos)
+			{
+				continue;
+			}
+
+			for (uint64_t Rep = 0; Rep < Opts.Repetitions; Rep++)
+			{
+				RunRecord Rec = RunSetting<T>(Kern, Set.How, Opts, LogOut);
+				Rec.Kernel = Kern.Name;
+				Rec.Setting = Set.Name;
+				Rec.Type = Type;
+				Rec.K = Opts.K;
+				Rec.Repetition = Rep;
+				Records.push_back(Rec);
+
+				/* Nothing reads the search's own log. */
+				LogOut.str("");
+				std::cerr << Kern.Name << " (" << Type << ", " << Set.Name << ", run " << Rep << "): "
+					<< (Rec.FoundErr / Rec.MaxErr) << " of the highest error in " << Rec.Seconds << " s" << std::endl;
+			}
+		}
+	}
+}
+
+static void WriteCSV(std::ostream &Out, const std::vector<RunRecord> &Records)
+{
+	Out << "kernel,setting,type,threads,k,repetition,seconds,generations,shadow_ops,max_err,found_err,found_fraction";
+	for (double Fraction : Milestones)
+	{
+		const std::string Percent = std::to_string((int)(Fraction * 100));
+		Out << ",seconds_to_" << Percent << ",shadow_ops_to_" << Percent << ",generations_to_" << Percent;
+	}
+	Out << std::endl;
+
+	for (const RunRecord &Rec : Records)
+	{
+		Out << Rec.Kernel << "," << Rec.Setting << "," << Rec.Type << "," << Rec.Threads << "," << Rec.K << ","
+			<< Rec.Repetition << "," << Rec.Seconds << "," << Rec.Generations << "," << Rec.ShadowOps << ","
+			<< Rec.MaxErr << "," << Rec.FoundErr << "," << (Rec.FoundErr / Rec.MaxErr);
+		for (const Milestone &Mark : Rec.Reached)
+		{
+			if (Mark.Reached)
+			{
+				Out << "," << Mark.Seconds << "," << Mark.ShadowOps << "," << Mark.Generation;
+			}
+			else
+			{
+				Out << ",,,";
+			}
+		}
+		Out << std::endl;
+	}
+}
+
+static void WriteJSON(std::ostream &Out, const std::vector<RunRecord> &Records)
+{
+	Out << "[" << std::endl;
+	for (uint64_t Index = 0; Index < Records.size(); Index++)
+	{
+		const RunRecord &Rec = Records[Index];
+		Out << "  {\"kernel\": \"" << Rec.Kernel << "\", \"setting\": \"" << Rec.Setting << "\", \"type\": \"" << Rec.Type
+			<< "\", \"threads\": " << Rec.Threads << ", \"k\": " << Rec.K << ", \"repetition\": " << Rec.Repetition
+			<< ", \"seconds\": " << Rec.Seconds << ", \"generations\": " << Rec.Generations
+			<< ", \"shadow_ops\": " << Rec.ShadowOps << ", \"max_err\": " << Rec.MaxErr << ", \"found_err\": " << Rec.FoundErr
+			<< ", \"found_fraction\": " << (Rec.FoundErr / Rec.MaxErr) << ", \"milestones\": [";
+		for (uint64_t Mark = 0; Mark < Milestones.size(); Mark++)
+		{
+			const Milestone &Reached = Rec.Reached[Mark];
+			Out << ((Mark == 0) ? "" : ", ") << "{\"fraction\": " << Milestones[Mark];
+			if (Reached.Reached)
+			{
+				Out << ", \"seconds\": " << Reached.Seconds << ", \"shadow_ops\": " << Reached.ShadowOps
+					<< ", \"generations\": " << Reached.Generation << "}";
+			}
+			else
+			{
+				Out << ", \"seconds\": null, \"shadow_ops\": null, \"generations\": null}";
+			}
+		}
+		Out << "]}" << ((Index + 1 < Records.size()) ? "," : "") << std::endl;
+	}
+	Out << "]" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+	Options Opts;
+	const auto Extra = [&Opts](const std::string &Arg, const std::string &Val)
+	{
+		if (Arg == "--setting")
+		{
+			Opts.Setting = Val;
+		}
+		else if (Arg == "--restart")
+		{
+			Opts.Restart = std::strtoull(Val.c_str(), nullptr, 10);
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	};
+	if (!bench::ParseOptions(argc, argv, Opts, Extra))
+	{
+		return 1;
+	}
+
+	dom::Init();
+
+	std::vector<RunRecord> Records;
+	if (Opts.Type != "double")
+	{
+		RunAll<float>("float", Opts, Records);
+	}
+	if (Opts.Type != "float")
+	{
+		RunAll<double>("double", Opts, Records);
+	}
+
+	if (!bench::WriteRecords(Opts, Records, WriteCSV, WriteJSON))
+	{
+		return 1;
+	}
+	return 0;
+}
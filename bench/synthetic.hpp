@@ -0,0 +1,155 @@
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <unordered_map>
+
+#include <domain.hpp>
+
+#ifndef DOMAIN_BENCH_SYNTHETIC_HPP_
+#define DOMAIN_BENCH_SYNTHETIC_HPP_
+
+/**
+ * @file bench/synthetic.hpp
+ * @brief Kernels whose highest possible error is known exactly, so a search can be scored against it
+ *
+ * Every input is sampled as a real number x in its range [a, b], and bgrt::Variable::Sample rounds it to T twice: first the
+ * offset x - a, and then a plus that. So an input in [1, 2) starts out with up to u (the unit roundoff, half an ULP of 1) of
+ * error from the sum, and up to half an ULP of the offset more: u/4 for offsets in [1/4, 1/2), and u(2^-9) for offsets
+ * below 2^-8. Each kernel is built so that, apart from that, only known operations round.
+ * The maximum given for each is an upper bound on its absolute error over its inputs which a search can come arbitrarily
+ * close to. Terms of order u^2 are left out, so a search can exceed it by a relative amount of order u, and no more.
+ */
+
+namespace bench
+{
+
+template<typename T>
+using Array = std::unordered_map<uint64_t, dom::Value<T>>;
+
+/**
+ * @brief The unit roundoff of T: half an ULP of 1.
+ */
+template<typename T>
+dom::hpfloat UnitRoundoff()
+{
+	return (dom::hpfloat)std::numeric_limits<T>::epsilon() / 2;
+}
+
+/**
+ * @brief The width of the ranges near 1 which Cancel and Horner search over.
+ */
+inline dom::hpfloat NearOne()
+{
+	return (dom::hpfloat)1.0 / 256;
+}
+
+/**
+ * @brief a - b, with a and b in [1, 1 + 2^-8].
+ * @details The subtraction is exact (Sterbenz), so the error is only that of rounding each input: at most 2u(1 + 2^-9), when
+ * a rounds down by u(1 + 2^-9) and b rounds up by as much. Since the result is tiny, the relative error is enormous.
+ */
+template<typename T>
+Array<T> Cancel(Array<T> &Arr)
+{
+	Array<T> RetVal;
+	RetVal[0] = Arr[0] - Arr[1];
+	return RetVal;
+}
+
+/**
+ * @brief L + s_1 + ... + s_N from left to right, with L in [1, 1.5] and every s_i in [0, u].
+ * @details Each s_i is below half an ULP of the running sum, so every one of them is lost: this is the worst order to add
+ * them in. The error is at most (N + 5/4)u: 5u/4 from rounding L, and u from each s_i.
+ */
+template<typename T, uint64_t N>
+Array<T> Absorb(Array<T> &Arr)
+{
+	dom::Value<T> Sum = Arr[0];
+	for (uint64_t Index = 1; Index <= N; Index++)
+	{
+		Sum = Sum + Arr[Index];
+	}
+
+	Array<T> RetVal;
+	RetVal[0] = Sum;
+	return RetVal;
+}
+
+/**
+ * @brief (x - 2)x + 1 by Horner's rule, which is (x - 1)^2, with x in [1, 1 + 2^-8], near its double root.
+ * @details x - 2 and the final + 1 are exact (Sterbenz), and (x - 2)x has magnitude just under 1, so it rounds by at most u/2.
+ * Rounding x by up to u(1 + 2^-9) moves (x - 1)^2 by up to 2u(2^-8)(1 + 2^-9) more, so the error is at most
+ * u(1/2 + 2^-7(1 + 2^-9)).
+ */
+template<typename T>
+Array<T> Horner(Array<T> &Arr)
+{
+	const dom::Value<T> One((dom::hpfloat)1.0);
+	const dom::Value<T> Two((dom::hpfloat)2.0);
+
+	Array<T> RetVal;
+	RetVal[0] = ((Arr[0] - Two) * Arr[0]) + One;
+	return RetVal;
+}
+
+/**
+ * @brief A kernel, the range of each of its inputs, and its highest possible error.
+ */
+template<typename T>
+struct Synthetic
+{
+	const char *Name;
+	Array<T> (*F)(Array<T>&);
+	std::vector<std::pair<dom::hpfloat, dom::hpfloat>> Ranges;
+	dom::hpfloat MaxError;
+
+	/**
+	 * @brief The initial configuration to search from.
+	 */
+	std::unordered_map<uint64_t, bgrt::Variable<T>> Init() const
+	{
+		std::unordered_map<uint64_t, bgrt::Variable<T>> RetVal;
+		for (uint64_t Index = 0; Index < this->Ranges.size(); Index++)
+		{
+			RetVal[Index] = bgrt::Variable<T>(this->Ranges[Index].first, this->Ranges[Index].second);
+		}
+		return RetVal;
+	}
+};
+
+/**
+ * @brief Absorb of N terms, along with its ranges and highest error.
+ */
+template<typename T, uint64_t N>
+Synthetic<T> MakeAbsorb(const char *Name)
+{
+	const dom::hpfloat U = UnitRoundoff<T>();
+	Synthetic<T> RetVal{Name, Absorb<T, N>, {{(dom::hpfloat)1.0, (dom::hpfloat)1.5}}, U * (N + 1.25)};
+	for (uint64_t Index = 0; Index < N; Index++)
+	{
+		RetVal.Ranges.push_back({(dom::hpfloat)0.0, U});
+	}
+	return RetVal;
+}
+
+/**
+ * @brief Every synthetic kernel, in precision T.
+ */
+template<typename T>
+std::vector<Synthetic<T>> Synthetics()
+{
+	const dom::hpfloat U = UnitRoundoff<T>();
+	const dom::hpfloat One = 1.0;
+	return {
+		Synthetic<T>{"Cancel", Cancel<T>, {{One, One + NearOne()}, {One, One + NearOne()}}, U * (2 + NearOne())},
+		MakeAbsorb<T, 8>("Absorb 8"),
+		MakeAbsorb<T, 32>("Absorb 32"),
+		MakeAbsorb<T, 128>("Absorb 128"),
+		Synthetic<T>{"Horner", Horner<T>, {{One, One + NearOne()}}, U * (0.5 + (2 * NearOne() * (1 + (NearOne() / 2))))},
+	};
+}
+
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include <array>
+#include <cstdlib>
 #include <random>
 #include <vector>
 
@@ -10,9 +11,58 @@
 #ifndef BGRT_HPP_
 #define BGRT_HPP_
 
+#if !defined(ACCURATE_RANDOM) && !defined(FAIR_RANDOM) && !defined(OKAY_RANDOM) && !defined(TIME_RANDOM)
+#define FAIR_RANDOM
+#endif
+
+#if (defined(ACCURATE_RANDOM) + defined(FAIR_RANDOM) + defined(OKAY_RANDOM) + defined(TIME_RANDOM)) != 1
+#error "Define at most one of ACCURATE_RANDOM, FAIR_RANDOM, OKAY_RANDOM, and TIME_RANDOM"
+#endif
+
+/*
+ * Variable::Sample is chosen at compile time, so everything which samples is put into a namespace named after the way it
+ * samples. A file sampling with OKAY_RANDOM then instantiates bgrt::okay_random::Variable<float> (and every driver taking
+ * one), rather than a second, different definition of the same Variable<float> libdomain was built with.
+ */
+#if defined(ACCURATE_RANDOM)
+#define BGRT_RANDOM_NAMESPACE accurate_random
+#elif defined(FAIR_RANDOM)
+#define BGRT_RANDOM_NAMESPACE fair_random
+#elif defined(OKAY_RANDOM)
+#define BGRT_RANDOM_NAMESPACE okay_random
+#elif defined(TIME_RANDOM)
+#define BGRT_RANDOM_NAMESPACE time_random
+#endif
+
 namespace bgrt
 {
 
+/**
+ * @brief The generator variables are sampled with. Every worker samples at once, so each thread gets its own.
+ */
+inline std::mt19937 &SampleGenerator()
+{
+	thread_local std::random_device Dev;
+	thread_local std::mt19937 Gen(Dev());
+	return Gen;
+}
+
+/**
+ * @brief Restarts sampling on the current thread from a new seed.
+ * @details A process forked from another has a copy of its generator, and would otherwise draw the same samples as every
+ * other process forked from the same one. Each should call this with its own seed before sampling anything.
+ * @param Seed The seed to restart from
+ */
+inline void Reseed(uint64_t Seed)
+{
+	std::seed_seq Seq{(uint32_t)Seed, (uint32_t)(Seed >> 32)};
+	SampleGenerator().seed(Seq);
+	srand((unsigned int)Seed);
+}
+
+inline namespace BGRT_RANDOM_NAMESPACE
+{
+
 template<typename T>
 class Variable
 {
@@ -90,19 +140,14 @@ public:
 
 	dom::Value<T> Sample() const
 	{
-		static std::random_device Dev;
-		static std::mt19937 Gen(Dev());
-		static std::uniform_int_distribution<int64_t> SDist(INT64_MIN, INT64_MAX);
-
-
-#if !defined(ACCURATE_RANDOM) && !defined(FAIR_RANDOM) && !defined(OKAY_RANDOM) && !defined(TIME_RANDOM)
-#define FAIR_RANDOM
-#endif
+		thread_local std::uniform_int_distribution<int64_t> SDist(INT64_MIN, INT64_MAX);
 
 #ifdef ACCURATE_RANDOM
+		std::mt19937 &Gen = SampleGenerator();
 		dom::hpfloat RandScale = this->Maximum.SVal() - this->Minimum.SVal();
 		dom::hpfloat RandNumber = mpfr::random(SDist(Gen));
 #elif defined(FAIR_RANDOM)
+		std::mt19937 &Gen = SampleGenerator();
 		std::uniform_real_distribution<double> RDist(0.0, 1.0);
 		std::uniform_real_distribution<double> Dist(0.0, (double)(this->Maximum.SVal() - this->Minimum.SVal()));
 		dom::hpfloat RandScale = Dist(Gen);
@@ -300,16 +345,39 @@ public:
 		RetVal[0].reserve(this->Vals.bucket_count() / 2);
 		RetVal[1].reserve(this->Vals.bucket_count() / 2);
 
-		static std::uniform_int_distribution<int> Dist(0, 1);
-		static std::random_device Dev;
-		static std::mt19937 Gen(Dev());
+		/* Several searches may be running at once, so each thread gets its own generator. */
+		thread_local std::uniform_int_distribution<int> Dist(0, 1);
+		thread_local std::uniform_real_distribution<double> Chance(0.0, 1.0);
+		thread_local std::random_device Dev;
+		thread_local std::mt19937 Gen(Dev());
 		for (const auto &Pair : this->Vals)
 		{
-			int Selection = Dist(Gen);
+			int Selection = 0;
+			auto Biased = this->Bias.find(Pair.first);
+			if (Biased == this->Bias.end())
+			{
+				Selection = Dist(Gen);
+			}
+			else
+			{
+				Selection = (Chance(Gen) < Biased->second) ? 0 : 1;
+			}
 			RetVal[Selection][Pair.first] = Pair.second;
 		}
 		return RetVal;
 	}
+
+	/**
+	 * @brief Guides PartConf, rather than splitting variables into groups uniformly at random.
+	 * @details Variables in the same group are moved in the same direction by NextGen, and the two groups in opposite directions.
+	 * Giving variables which push the output the same way a high chance of sharing a group lets the search reach the extremes of
+	 * the output sooner. Variables without a bias are split as before, with even odds.
+	 * @param Bias The chance (between 0 and 1) of each variable, by key, being placed into the first group
+	 */
+	void SetBias(const std::unordered_map<uint64_t, double> &Bias)
+	{
+		this->Bias = Bias;
+	}
 	
 	/* Refer to Section 3.4 in the S3FP paper */
 	[[nodiscard]]
@@ -366,9 +434,12 @@ public:
 	
 private:
 	Configuration Vals;
+	std::unordered_map<uint64_t, double> Bias;
 };
 
 }
 
+}
+
 
 #endif
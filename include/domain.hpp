@@ -21,8 +21,20 @@
 #include "impl/partition.hpp"
 
 #include "domain/base.hpp"
+#include "domain/policy.hpp"
+#include "domain/options.hpp"
+#include "domain/control.hpp"
+#include "domain/engine.hpp"
+#include "domain/executor.hpp"
 #include "domain/util.hpp"
 #include "domain/multithread.hpp"
+#include "domain/async.hpp"
+#include "domain/distribution.hpp"
+#include "domain/sensitivity.hpp"
+#include "domain/dependency.hpp"
+#include "domain/trace.hpp"
+#include "domain/profile.hpp"
+#include "domain/timeline.hpp"
 
 #ifndef LIBDOMAIN_HPP_
 #define LIBDOMAIN_HPP_
@@ -197,111 +209,19 @@ hpfloat FindError(const Array<T, Size> &Lower, const Array<T, Size> &Higher,
  * @param k The number of times to execute F, looking for potential error
  * @param LogFreq Operand to (Resoruces % LogFreq), for when error will be logged to LogOut. Default is 5000.
  * @param LogOut A stream to send messages to for logging. Default is std::cout.
- * @param NumThreads The number of threads to be using for finding error. 0 (default) gets all possible threads.
+ * @param Options How to run the search, and what else to report. See SearchOptions. There is only one worker, so NumThreads and PinThreads are ignored.
  * @return The highest error of the function that was ever found, described as "WorstError" in the paper
  */
 template<typename T>
 EvalResults FindErrorMantissa(const std::unordered_map<uint64_t, bgrt::Variable<T>> &InitConf,
 		std::unordered_map<uint64_t, dom::Value<T>> (*F)(std::unordered_map<uint64_t, dom::Value<T>>&),
 		const uint64_t Iterations = 1000, const int64_t Resources = 0, T Scale = 1.0, const uint64_t RestartPercent = 15,
-		uint64_t k = 50, uint64_t LogFreq = 5000, std::ostream &LogOut = std::cout)
+		uint64_t k = 50, uint64_t LogFreq = 5000, std::ostream &LogOut = std::cout, const SearchOptions &Options = {})
 {
-	T Lim = std::numeric_limits<T>::epsilon();
-
-	dom::hpfloat hLim = (dom::hpfloat)Lim;
-
-	/* Don't allow using something of the same size as the high precision float. */
-	static_assert(sizeof(T) != sizeof(dom::hpfloat));
-
-	bool RandomRestart = false;
-	EvalResults WorstError = EvalResults{};
-	EvalResults LocalError = EvalResults{};
-	
-	using Var = bgrt::Variable<T>;
-	using Configuration = std::unordered_map<uint64_t, Var>;
-	
-	Configuration LocalConf = InitConf;
-	bgrt::BGRTState BGRT(LocalConf);
-
-	static std::random_device Dev;
-	static std::mt19937 Gen(Dev());
-	static std::uniform_int_distribution<int> Dist(0, 100);
-
-	bool ResourcesAvailable = true;
-	while (ResourcesAvailable)
-	{
-		LocalError = EvalResults{};
-		std::vector<Configuration> NextConfs = BGRT.NextGen(Iterations);
-		
-		/* Use a lambda to apply filtering to the next configurations to apply.
-		 * In this case, prune any job which has the size less than the range
-		 * (ie, the delta between min and max interval < some range)
-		 */
-		uint64_t TotalJobs = 0;
-
-		for (const auto &Config : NextConfs)
-		{
-			bool Okay = true;
-			for (const auto &Pair : Config)
-			{
-				dom::hpfloat RangeSize = Pair.second.Size().SVal();
-				
-				dom::hpfloat Min = Pair.second.Min().SVal();
-				dom::hpfloat Max = Pair.second.Max().SVal();
-				dom::hpfloat Bigger = (Min < Max) ? Min : Max;
-
-				dom::hpfloat Eps = 0.5 * Lim * (Resources + 1);
-				dom::hpfloat Filter = Scale * (Bigger * Eps);
-				Filter = (Filter < 0) ? -Filter : Filter;
-
-				if (RangeSize < Filter)
-				{
-					Okay = false;
-				}
-			}
-
-			if (Okay)
-			{
-				EvalResults Res = Eval(F, Config, k);
-				dom::hpfloat Err = Res.Err;
-				if (Err > LocalError.Err)
-				{
-					LocalError = Res;
-					LocalConf = Config;
-					BGRT.SetVals(LocalConf);
-				}				
-			}
-			TotalJobs += (1 * Okay);
-		}
-
-		/* We're done if every possible job was too close to the boundary. */
-		if (TotalJobs == 0)
-		{
-			ResourcesAvailable = false;
-			break;
-		}
-
-		/* Is the error in this configuration higher than the global maximum? */
-		if (LocalError.Err > WorstError.Err)
-		{
-			WorstError = LocalError;
-		}
-
-		if ((Dist(Gen) * Dist(Gen)) <= LogFreq)
-		{
-			LogOut << "(CurError " << "(abs " << WorstError.Err << ")" << ", (rel " << WorstError.RelErr << "))" << std::endl;
-		}
-
-		/* Sometimes re-issue the original configuration, to avoid getting stuck. */
-		RandomRestart = (Dist(Gen) % 100) < RestartPercent;
-		if (RandomRestart)
-		{
-			LocalConf = InitConf;
-			BGRT.SetVals(LocalConf);
-		}
-	}
-
-	return WorstError;
+	dom::SerialExecutor<T> Exec;
+	dom::SearchEngine<T, dom::FilterExhausted, dom::MantissaRangeFilter<T>, dom::RandomRestart, dom::SerialExecutor<T>> Engine(F, Exec,
+		dom::FilterExhausted{}, dom::MantissaRangeFilter<T>(Resources, Scale), dom::RandomRestart{RestartPercent}, Iterations, k, LogFreq, LogOut);
+	return Engine.Run(InitConf, Options);
 }
 
 /**
@@ -316,98 +236,71 @@ EvalResults FindErrorMantissa(const std::unordered_map<uint64_t, bgrt::Variable<
  * @param k The number of times to execute F, looking for potential error
  * @param LogFreq Chance (out of 1000) that a log is printed after any given level of configurations. Default is 4000.
  * @param LogOut A stream to send messages to for logging. Default is std::cout.
+ * @param Options How to run the search, and what else to report. See SearchOptions. There is only one worker, so NumThreads and PinThreads are ignored.
  * @return The highest error of the function that was ever found, described as "WorstError" in the paper
  */
 template<typename T>
 EvalResults FindErrorBoundConf(const std::unordered_map<uint64_t, bgrt::Variable<T>> &InitConf,
 		std::unordered_map<uint64_t, dom::Value<T>> (*F)(std::unordered_map<uint64_t, dom::Value<T>>&),
 		const uint64_t Iterations = 1000, const dom::hpfloat MinRange = std::numeric_limits<T>::epsilon(), 
-		const uint64_t RestartPercent = 15, uint64_t k = 50, uint64_t LogFreq = 4000, std::ostream &LogOut = std::cout)
+		const uint64_t RestartPercent = 15, uint64_t k = 50, uint64_t LogFreq = 4000, std::ostream &LogOut = std::cout,
+		const SearchOptions &Options = {})
 {
-	/* Don't allow using something of the same size as the high precision float. */
-	static_assert(sizeof(T) != sizeof(dom::hpfloat));
-
-	bool RandomRestart = false;
-	EvalResults WorstError = EvalResults{};
-	EvalResults LocalError = EvalResults{};
-	
-	using Var = bgrt::Variable<T>;
-	using Configuration = std::unordered_map<uint64_t, Var>;
-	
-	Configuration LocalConf = InitConf;
-	bgrt::BGRTState BGRT(LocalConf);
-
-	static std::random_device Dev;
-	static std::mt19937 Gen(Dev());
-	static std::uniform_int_distribution<int> Dist(0, 100);
-
-	bool ResourcesAvailable = true;
-	while (ResourcesAvailable)
-	{
-		LocalError = EvalResults{};
-		std::vector<Configuration> NextConfs = BGRT.NextGen(Iterations);
-		
-		/* Use a lambda to apply filtering to the next configurations to apply.
-		 * In this case, prune any job which has the size less than the range
-		 * (ie, the delta between min and max interval < some range)
-		 */
-		uint64_t TotalJobs = 0;
-
-		for (const auto &Config : NextConfs)
-		{
-			bool Okay = true;
-			for (const auto &Pair : Config)
-			{
-				if (Pair.second.Size().SVal() < MinRange)
-				{
-					Okay = false;
-				}
-			}
-
-			if (Okay)
-			{
-				EvalResults Res = Eval(F, Config, k);
-				dom::hpfloat Err = Res.Err;
-				if (Err > LocalError.Err)
-				{
-					LocalError = Res;
-					LocalConf = Config;
-					BGRT.SetVals(LocalConf);
-				}				
-			}
-			TotalJobs += (1 * Okay);
-		}
-
-		/* We're done if every possible job was too close to the boundary. */
-		if (TotalJobs == 0)
-		{
-			ResourcesAvailable = false;
-			break;
-		}
+	dom::SerialExecutor<T> Exec;
+	dom::SearchEngine<T, dom::FilterExhausted, dom::MinRangeFilter, dom::RandomRestart, dom::SerialExecutor<T>> Engine(F, Exec,
+		dom::FilterExhausted{}, dom::MinRangeFilter{MinRange}, dom::RandomRestart{RestartPercent}, Iterations, k, LogFreq, LogOut);
+	return Engine.Run(InitConf, Options);
+}
 
-		/* Is the error in this configuration higher than the global maximum? */
-		if (LocalError.Err > WorstError.Err)
-		{
-			WorstError = LocalError;
-		}
+namespace impl
+{
 
-		if ((Dist(Gen) * Dist(Gen)) <= LogFreq)
-		{
-			LogOut << "(CurError " << "(abs " << WorstError.Err << ")" << ", (rel " << WorstError.RelErr << "))" << std::endl;
-		}
+template<typename T>
+using InitConfig = std::unordered_map<uint64_t, bgrt::Variable<T>>;
 
-		/* Sometimes re-issue the original configuration, to avoid getting stuck. */
-		RandomRestart = (Dist(Gen) % 100) < RestartPercent;
-		if (RandomRestart)
-		{
-			LocalConf = InitConf;
-			BGRT.SetVals(LocalConf);
-		}
-	}
+template<typename T>
+using Kernel = std::unordered_map<uint64_t, dom::Value<T>> (*)(std::unordered_map<uint64_t, dom::Value<T>>&);
 
-	return WorstError;
 }
 
+/**
+ * @brief Every driver (and the other entry points taking a function to search), for one type T.
+ * @details For float and double, these are compiled once, into libdomain (see Lib.cpp), rather than in every file which
+ * uses them: everywhere else, they are only declared, with Kind as "extern template". This skips compiling the whole search
+ * engine again for every kernel. Define DOMAIN_NO_EXTERN_TEMPLATES before including domain.hpp to compile them locally anyway.
+ *
+ * libdomain samples however it was built to (DOMAIN_RANDOM in CMake, FAIR_RANDOM by default), and so must everything linking
+ * it. The way of sampling is part of the name of bgrt::Variable, so a file sampling any other way fails to link, rather than
+ * mixing two different definitions of the same driver.
+ */
+#define DOMAIN_INSTANTIATE(Kind, T) \
+	Kind hpfloat FindError<T>(const impl::InitConfig<T>&, impl::Kernel<T>, uint64_t, int64_t, uint64_t, uint64_t, uint64_t, \
+		std::ostream&, const SearchOptions&); \
+	Kind EvalResults FindErrorMantissa<T>(const impl::InitConfig<T>&, impl::Kernel<T>, uint64_t, int64_t, T, uint64_t, uint64_t, \
+		uint64_t, std::ostream&, const SearchOptions&); \
+	Kind EvalResults FindErrorBoundConf<T>(const impl::InitConfig<T>&, impl::Kernel<T>, uint64_t, hpfloat, uint64_t, uint64_t, \
+		uint64_t, std::ostream&, const SearchOptions&); \
+	Kind EvalResults FindErrorMultithread<T>(const impl::InitConfig<T>&, impl::Kernel<T>, uint64_t, int64_t, uint64_t, uint64_t, \
+		uint64_t, std::ostream&, const SearchOptions&); \
+	Kind EvalResults FindErrorBoundConfMultithread<T>(const impl::InitConfig<T>&, impl::Kernel<T>, uint64_t, hpfloat, uint64_t, \
+		uint64_t, uint64_t, std::ostream&, const SearchOptions&); \
+	Kind EvalResults FindErrorMantissaMultithread<T>(const impl::InitConfig<T>&, impl::Kernel<T>, uint64_t, int64_t, T, uint64_t, \
+		uint64_t, uint64_t, std::ostream&, const SearchOptions&); \
+	Kind AsyncSearch FindErrorMultithreadAsync<T>(const impl::InitConfig<T>&, impl::Kernel<T>, uint64_t, int64_t, uint64_t, \
+		uint64_t, uint64_t, std::ostream&, SearchOptions); \
+	Kind AsyncSearch FindErrorBoundConfMultithreadAsync<T>(const impl::InitConfig<T>&, impl::Kernel<T>, uint64_t, hpfloat, \
+		uint64_t, uint64_t, uint64_t, std::ostream&, SearchOptions); \
+	Kind AsyncSearch FindErrorMantissaMultithreadAsync<T>(const impl::InitConfig<T>&, impl::Kernel<T>, uint64_t, int64_t, T, \
+		uint64_t, uint64_t, uint64_t, std::ostream&, SearchOptions); \
+	Kind EvalResults Eval<T>(impl::Kernel<T>, const impl::InitConfig<T>&, uint64_t); \
+	Kind SensitivityReport Sensitivity<T>(impl::Kernel<T>, const impl::InitConfig<T>&, uint64_t); \
+	Kind DependencyReport Dependencies<T>(impl::Kernel<T>, const impl::InitConfig<T>&, uint64_t);
+
+#if !defined(DOMAIN_NO_EXTERN_TEMPLATES)
+DOMAIN_INSTANTIATE(extern template, float)
+DOMAIN_INSTANTIATE(extern template, double)
+#endif
+
 }
 
 #endif
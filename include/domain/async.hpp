@@ -0,0 +1,178 @@
+#include <chrono>
+#include <future>
+#include <memory>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+
+#include <value.hpp>
+#include <hpfloat.hpp>
+#include <bgrt/bgrt.hpp>
+
+#include "domain/util.hpp"
+#include "domain/policy.hpp"
+#include "domain/engine.hpp"
+#include "domain/control.hpp"
+#include "domain/options.hpp"
+#include "domain/executor.hpp"
+#include "domain/multithread.hpp"
+
+#ifndef DOMAIN_ASYNC_HPP_
+#define DOMAIN_ASYNC_HPP_
+
+/**
+ * @file include/domain/async.hpp
+ * @brief Searches which run in the background, so that several of them can be watched and stopped by the caller
+ */
+
+namespace dom
+{
+
+/**
+ * @brief A handle to a search running in the background.
+ * @details The result becomes ready once the search finishes, either by itself or by being cancelled.
+ * Until then, Poll() may be called at any rate from any thread, and never slows down the search.
+ * @author Brian Schnepp
+ */
+typedef struct AsyncSearch
+{
+	/* The worst error found by the search, once it is done */
+	std::future<EvalResults> Result;
+
+	/* Where the search publishes its progress after every generation */
+	std::shared_ptr<SearchProgress> Progress;
+
+	/* The token the search polls, which may also be given a deadline */
+	std::shared_ptr<CancellationToken> Token;
+
+	/**
+	 * @brief Reads the most recently published progress of the search.
+	 */
+	ProgressSnapshot Poll() const
+	{
+		return this->Progress->Read();
+	}
+
+	/**
+	 * @brief Asks the search to stop as soon as possible. The result is still the worst error found so far.
+	 */
+	void Cancel()
+	{
+		this->Token->Cancel();
+	}
+
+	/**
+	 * @brief Checks whether the search is done, without waiting for it.
+	 */
+	bool Ready() const
+	{
+		return this->Result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}
+}AsyncSearch;
+
+/**
+ * @brief Starts running a search on its own thread.
+ * @param Search The search to run, as Search(const CancellationToken*, SearchProgress*) -> EvalResults. It is moved onto the new thread.
+ * @return A handle to the running search
+ */
+template<typename SearchFn>
+AsyncSearch StartAsync(SearchFn Search)
+{
+	AsyncSearch RetVal;
+	RetVal.Progress = std::make_shared<SearchProgress>();
+	RetVal.Token = std::make_shared<CancellationToken>();
+
+	/* The precision of hpfloat may be per-thread, so carry the caller's over. */
+	mpfr_prec_t Prec = dom::hpfloat::get_default_prec();
+	RetVal.Result = std::async(std::launch::async,
+		[Search = std::move(Search), Progress = RetVal.Progress, Token = RetVal.Token, Prec]() mutable
+	{
+		dom::hpfloat::set_default_prec(Prec);
+		return Search(Token.get(), Progress.get());
+	});
+	return RetVal;
+}
+
+/**
+ * @brief Runs an existing SearchEngine in the background.
+ * @param Search The engine to run. It (and its executor) must outlive the search, and must not be used until it is done.
+ * @param InitConf The initial BGRT variable configuration, which is copied.
+ * @return A handle to the running search
+ */
+template<typename Engine>
+AsyncSearch RunAsync(Engine &Search, const typename Engine::Configuration &InitConf)
+{
+	return StartAsync([&Search, InitConf](const CancellationToken *Token, SearchProgress *Progress)
+	{
+		Search.SetCancellationToken(Token);
+		Search.SetProgress(Progress);
+		return Search.Run(InitConf);
+	});
+}
+
+/**
+ * @brief Runs FindErrorMultithread in the background.
+ * @details The parameters are the same as for FindErrorMultithread, but InitConf and Options are copied, and LogOut and
+ * whatever Options points to must outlive the search. Options.Token and Options.Progress are replaced by those of the handle.
+ * @return A handle to the running search
+ */
+template<typename T>
+AsyncSearch FindErrorMultithreadAsync(const std::unordered_map<uint64_t, bgrt::Variable<T>> &InitConf,
+		std::unordered_map<uint64_t, dom::Value<T>> (*F)(std::unordered_map<uint64_t, dom::Value<T>>&),
+		const uint64_t Iterations = 100, const int64_t Resources = INT32_MAX, const uint64_t RestartPercent = 5,
+		uint64_t k = 1000, uint64_t LogFreq = 5000, std::ostream &LogOut = std::cout,
+		SearchOptions Options = {})
+{
+	return StartAsync([=, &LogOut](const CancellationToken *Token, SearchProgress *Progress) mutable
+	{
+		Options.Token = Token;
+		Options.Progress = Progress;
+		return FindErrorMultithread<T>(InitConf, F, Iterations, Resources, RestartPercent, k, LogFreq, LogOut, Options);
+	});
+}
+
+/**
+ * @brief Runs FindErrorBoundConfMultithread in the background.
+ * @details The parameters are the same as for FindErrorBoundConfMultithread, but InitConf and Options are copied, and LogOut and
+ * whatever Options points to must outlive the search. Options.Token and Options.Progress are replaced by those of the handle.
+ * @return A handle to the running search
+ */
+template<typename T>
+AsyncSearch FindErrorBoundConfMultithreadAsync(const std::unordered_map<uint64_t, bgrt::Variable<T>> &InitConf,
+		std::unordered_map<uint64_t, dom::Value<T>> (*F)(std::unordered_map<uint64_t, dom::Value<T>>&),
+		const uint64_t Iterations = 100, const dom::hpfloat MinRange = std::numeric_limits<T>::epsilon(),
+		const uint64_t RestartPercent = 5, uint64_t k = 1000, uint64_t LogFreq = 4000, std::ostream &LogOut = std::cout,
+		SearchOptions Options = {})
+{
+	return StartAsync([=, &LogOut](const CancellationToken *Token, SearchProgress *Progress) mutable
+	{
+		Options.Token = Token;
+		Options.Progress = Progress;
+		return FindErrorBoundConfMultithread<T>(InitConf, F, Iterations, MinRange, RestartPercent, k, LogFreq, LogOut, Options);
+	});
+}
+
+/**
+ * @brief Runs FindErrorMantissaMultithread in the background.
+ * @details The parameters are the same as for FindErrorMantissaMultithread, but InitConf and Options are copied, and LogOut and
+ * whatever Options points to must outlive the search. Options.Token and Options.Progress are replaced by those of the handle.
+ * @return A handle to the running search
+ */
+template<typename T>
+AsyncSearch FindErrorMantissaMultithreadAsync(const std::unordered_map<uint64_t, bgrt::Variable<T>> &InitConf,
+		std::unordered_map<uint64_t, dom::Value<T>> (*F)(std::unordered_map<uint64_t, dom::Value<T>>&),
+		const uint64_t Iterations = 100, const int64_t Resources = 0, T Scale = 1.0, const uint64_t RestartPercent = 5,
+		uint64_t k = 1000, uint64_t LogFreq = 5000, std::ostream &LogOut = std::cout,
+		SearchOptions Options = {})
+{
+	return StartAsync([=, &LogOut](const CancellationToken *Token, SearchProgress *Progress) mutable
+	{
+		Options.Token = Token;
+		Options.Progress = Progress;
+		return FindErrorMantissaMultithread<T>(InitConf, F, Iterations, Resources, Scale, RestartPercent, k, LogFreq, LogOut, Options);
+	});
+}
+
+}
+
+#endif
@@ -0,0 +1,177 @@
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <cstdint>
+
+#ifndef DOMAIN_CONTROL_HPP_
+#define DOMAIN_CONTROL_HPP_
+
+/**
+ * @file include/domain/control.hpp
+ * @brief Cooperative cancellation and progress reporting of a running search
+ */
+
+namespace dom
+{
+
+/**
+ * @brief A token which tells a running search to stop early, either on request or once a wall-clock deadline passes.
+ * @details Workers poll the token every few samples, so a search stops shortly after the token expires,
+ * and returns the worst error found so far. Any thread may cancel the token or change the deadline while the search runs.
+ * @author Brian Schnepp
+ */
+class CancellationToken
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	CancellationToken() = default;
+	~CancellationToken() = default;
+
+	CancellationToken(const CancellationToken &Other) = delete;
+	CancellationToken &operator=(const CancellationToken &Other) = delete;
+
+	/**
+	 * @brief Constructs a token which expires after a given amount of time from now.
+	 * @param Timeout How long the search may run for
+	 */
+	explicit CancellationToken(Clock::duration Timeout)
+	{
+		this->SetTimeout(Timeout);
+	}
+
+	/**
+	 * @brief Asks any search using this token to stop as soon as possible.
+	 */
+	void Cancel()
+	{
+		this->Cancelled.store(true, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Sets the point in time after which any search using this token should stop.
+	 * @param When The deadline to use
+	 */
+	void SetDeadline(Clock::time_point When)
+	{
+		this->Deadline.store(When.time_since_epoch().count(), std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Sets the deadline to some amount of time from now.
+	 * @param Timeout How long the search may run for, starting now
+	 */
+	void SetTimeout(Clock::duration Timeout)
+	{
+		this->SetDeadline(Clock::now() + Timeout);
+	}
+
+	/**
+	 * @brief Checks whether Cancel() was called, without looking at the deadline.
+	 */
+	bool IsCancelled() const
+	{
+		return this->Cancelled.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Checks whether a search using this token should stop, either from being cancelled or from running out of time.
+	 */
+	bool Expired() const
+	{
+		if (this->Cancelled.load(std::memory_order_relaxed))
+		{
+			return true;
+		}
+
+		Clock::rep When = this->Deadline.load(std::memory_order_relaxed);
+		return When != NoDeadline && Clock::now().time_since_epoch().count() >= When;
+	}
+
+private:
+	static constexpr Clock::rep NoDeadline = std::numeric_limits<Clock::rep>::max();
+
+	std::atomic_bool Cancelled = false;
+	std::atomic<Clock::rep> Deadline = NoDeadline;
+};
+
+/**
+ * @brief A point-in-time view of how a search is doing.
+ */
+typedef struct ProgressSnapshot
+{
+	/* The worst absolute error found so far, rounded to a double */
+	double WorstError;
+
+	/* Number of generations completed so far */
+	uint64_t Generations;
+
+	/* Number of shadow value computations performed so far */
+	uint64_t ShadowOps;
+
+	/* Number of times F was sampled so far, and the average rate since the search started */
+	uint64_t Samples;
+	double SamplesPerSecond;
+
+	/* Incremented every time the search publishes, so readers can tell whether anything changed */
+	uint64_t Updates;
+}ProgressSnapshot;
+
+/**
+ * @brief A lock-free channel through which a running search publishes its progress once per generation.
+ * @details The search is the only writer. Any number of readers may poll it at any time without ever blocking the search.
+ * Each field is individually up to date, but a snapshot may mix two consecutive generations.
+ * @author Brian Schnepp
+ */
+class SearchProgress
+{
+public:
+	SearchProgress() = default;
+	~SearchProgress() = default;
+
+	SearchProgress(const SearchProgress &Other) = delete;
+	SearchProgress &operator=(const SearchProgress &Other) = delete;
+
+	static_assert(std::atomic<double>::is_always_lock_free);
+	static_assert(std::atomic_uint64_t::is_always_lock_free);
+
+	/**
+	 * @brief Publishes the state of the search. Only the search itself should call this.
+	 */
+	void Publish(const ProgressSnapshot &Snap)
+	{
+		this->WorstError.store(Snap.WorstError, std::memory_order_relaxed);
+		this->Generations.store(Snap.Generations, std::memory_order_relaxed);
+		this->ShadowOps.store(Snap.ShadowOps, std::memory_order_relaxed);
+		this->Samples.store(Snap.Samples, std::memory_order_relaxed);
+		this->SamplesPerSecond.store(Snap.SamplesPerSecond, std::memory_order_relaxed);
+		this->Updates.fetch_add(1, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Reads the most recently published state of the search.
+	 */
+	ProgressSnapshot Read() const
+	{
+		ProgressSnapshot RetVal;
+		RetVal.Updates = this->Updates.load(std::memory_order_acquire);
+		RetVal.WorstError = this->WorstError.load(std::memory_order_relaxed);
+		RetVal.Generations = this->Generations.load(std::memory_order_relaxed);
+		RetVal.ShadowOps = this->ShadowOps.load(std::memory_order_relaxed);
+		RetVal.Samples = this->Samples.load(std::memory_order_relaxed);
+		RetVal.SamplesPerSecond = this->SamplesPerSecond.load(std::memory_order_relaxed);
+		return RetVal;
+	}
+
+private:
+	std::atomic<double> WorstError = 0.0;
+	std::atomic_uint64_t Generations = 0;
+	std::atomic_uint64_t ShadowOps = 0;
+	std::atomic_uint64_t Samples = 0;
+	std::atomic<double> SamplesPerSecond = 0.0;
+	std::atomic_uint64_t Updates = 0;
+};
+
+}
+
+#endif
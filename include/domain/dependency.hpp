@@ -0,0 +1,149 @@
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <value.hpp>
+#include <hpfloat.hpp>
+#include <bgrt/bgrt.hpp>
+
+#include "impl/tape.hpp"
+
+#ifndef DOMAIN_DEPENDENCY_HPP_
+#define DOMAIN_DEPENDENCY_HPP_
+
+/**
+ * @file include/domain/dependency.hpp
+ * @brief Finding which inputs of a function can affect its outputs at all, so the rest can be left out of the search
+ */
+
+namespace dom
+{
+
+/**
+ * @brief Which inputs each output of a function was computed from.
+ * @author Brian Schnepp
+ */
+typedef struct DependencyReport
+{
+	/* By key of the output, the keys of every input it was computed from */
+	std::unordered_map<uint64_t, std::unordered_set<uint64_t>> Outputs;
+
+	/* The keys of every input which was used in a comparison, and so may decide a branch affecting any output */
+	std::unordered_set<uint64_t> Branches;
+
+	/* The keys of every input which reached no output and no comparison */
+	std::unordered_set<uint64_t> Unused;
+
+	/* The number of times the function was run */
+	uint64_t Samples;
+
+	/**
+	 * @brief Whether an input was seen to affect the function at all.
+	 */
+	bool Used(uint64_t Key) const
+	{
+		return this->Unused.find(Key) == this->Unused.end();
+	}
+}DependencyReport;
+
+/**
+ * @brief Finds which inputs of P reach which of its outputs, across a configuration.
+ * @details P is run at several random points within C while recording a tape of every operation on its Values, and the tape is
+ * followed back from each output to the inputs it was computed from. An input counts as used if it reaches any output
+ * (even through a derivative of zero, such as by multiplying by zero), or if it was ever compared against anything,
+ * since it could then decide which way P branches. Only arithmetic on Values is seen: an input which P converts to a plain
+ * number and back is reported as unused, even if it isn't.
+ * @author Brian Schnepp
+ * @param P The function to analyze
+ * @param C The ranges of each input to sample within
+ * @param Samples How many points to run P at. Any input used at any of them counts as used.
+ * @return The inputs each output depends on
+ */
+template<typename T>
+DependencyReport Dependencies(std::unordered_map<uint64_t, dom::Value<T>> (*P)(std::unordered_map<uint64_t, dom::Value<T>>&),
+	const std::unordered_map<uint64_t, bgrt::Variable<T>> &C, uint64_t Samples = 4)
+{
+	using Array = std::unordered_map<uint64_t, dom::Value<T>>;
+
+	DependencyReport RetVal;
+	RetVal.Samples = Samples;
+
+	impl::Tape Rec;
+	Array Inputs;
+	std::unordered_map<uint64_t, uint32_t> Leaves;
+	for (uint64_t Sample = 0; Sample < Samples; Sample++)
+	{
+		Rec.Clear();
+		impl::ScopedTape Recording(Rec);
+
+		for (const auto &Pair : C)
+		{
+			Inputs[Pair.first] = Pair.second.Sample();
+			Leaves[Pair.first] = Inputs[Pair.first].Track();
+		}
+		const Array Outputs = P(Inputs);
+
+		for (const auto &Out : Outputs)
+		{
+			std::vector<uint8_t> Seen = Rec.Reachable(std::vector<uint32_t>{Out.second.TapeNode()});
+			std::unordered_set<uint64_t> &Deps = RetVal.Outputs[Out.first];
+			for (const auto &Leaf : Leaves)
+			{
+				if (Seen[Leaf.second])
+				{
+					Deps.insert(Leaf.first);
+				}
+			}
+		}
+
+		std::vector<uint8_t> Tested = Rec.Reachable(Rec.Tested());
+		for (const auto &Leaf : Leaves)
+		{
+			if (Tested[Leaf.second])
+			{
+				RetVal.Branches.insert(Leaf.first);
+			}
+		}
+	}
+
+	for (const auto &Pair : C)
+	{
+		bool Found = RetVal.Branches.find(Pair.first) != RetVal.Branches.end();
+		for (const auto &Out : RetVal.Outputs)
+		{
+			Found = Found || (Out.second.find(Pair.first) != Out.second.end());
+		}
+		if (!Found)
+		{
+			RetVal.Unused.insert(Pair.first);
+		}
+	}
+	return RetVal;
+}
+
+/**
+ * @brief Removes every input which was found to be unused from a configuration.
+ * @details If nothing is used at all (for example, if every output is a constant), the configuration is returned as is.
+ * @param C The configuration to remove inputs from
+ * @param Report The dependencies found for the function over C
+ * @return C, without any unused inputs
+ */
+template<typename T>
+std::unordered_map<uint64_t, bgrt::Variable<T>> DropUnused(const std::unordered_map<uint64_t, bgrt::Variable<T>> &C,
+	const DependencyReport &Report)
+{
+	std::unordered_map<uint64_t, bgrt::Variable<T>> RetVal;
+	for (const auto &Pair : C)
+	{
+		if (Report.Used(Pair.first))
+		{
+			RetVal[Pair.first] = Pair.second;
+		}
+	}
+	return RetVal.empty() ? C : RetVal;
+}
+
+}
+
+#endif
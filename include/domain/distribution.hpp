@@ -0,0 +1,272 @@
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <hpfloat.hpp>
+
+#ifndef DOMAIN_DISTRIBUTION_HPP_
+#define DOMAIN_DISTRIBUTION_HPP_
+
+/**
+ * @file include/domain/distribution.hpp
+ * @brief Streaming statistics over every error seen by Eval, rather than only the largest one
+ */
+
+namespace dom
+{
+
+namespace impl
+{
+class Serializer;
+class Deserializer;
+}
+
+/**
+ * @brief One bin of an error histogram, covering errors in [Lower, Upper).
+ */
+typedef struct ErrorBin
+{
+	double Lower;
+	double Upper;
+	uint64_t Count;
+}ErrorBin;
+
+/**
+ * @brief Collects the distribution of absolute errors, one sample at a time, without keeping the samples around.
+ * @details Errors are counted in logarithmic bins: every power of two is split into SubBins equal parts, so any quantile
+ * is known to within about 9% of its true value, no matter the scale of the error. Errors outside of
+ * [2^MinExp, 2^(MaxExp+1)) are counted in the first or last bin. Exact zeros are counted separately, and so are
+ * infinite and NaN errors (which happen whenever T overflows or divides by zero): those are left out of the histogram,
+ * the mean and the quantiles, and are reported by NonFiniteCount() instead.
+ * This tells apart a single spike of error from a heavy tail, in constant memory.
+ *
+ * Collectors are not thread-safe: each thread should have its own, and they can be combined with Merge() afterwards.
+ * @author Brian Schnepp
+ */
+class alignas(64) ErrorStatistics
+{
+public:
+	static constexpr int64_t MinExp = -256;
+	static constexpr int64_t MaxExp = 255;
+	static constexpr int64_t SubBins = 8;
+	static constexpr int64_t NumBins = (MaxExp - MinExp + 1) * SubBins;
+
+	ErrorStatistics() : Bins(NumBins, 0)
+	{
+	}
+
+	/**
+	 * @brief Counts one error.
+	 * @param Output The key of the output of P the error was seen in
+	 * @param Err The absolute error
+	 */
+	void Record(uint64_t Output, const dom::hpfloat &Err)
+	{
+		double Val = mpfr_get_d(Err.mpfr_srcptr(), MPFR_RNDN);
+		this->Total++;
+
+		double &OutMax = this->OutputMax[Output];
+		if (!std::isfinite(Val))
+		{
+			/* Counted, and the output marked as broken, but kept away from the sum and the bins. */
+			this->NonFinite++;
+			OutMax = INFINITY;
+			return;
+		}
+
+		this->Sum += Val;
+		this->Largest = (Val > this->Largest) ? Val : this->Largest;
+		OutMax = (Val > OutMax) ? Val : OutMax;
+
+		if (Val <= 0.0)
+		{
+			this->Zeros++;
+			return;
+		}
+		this->Bins[BinOf(Val)]++;
+	}
+
+	/**
+	 * @brief Adds everything another collector has seen to this one.
+	 */
+	void Merge(const ErrorStatistics &Other)
+	{
+		this->Total += Other.Total;
+		this->Zeros += Other.Zeros;
+		this->NonFinite += Other.NonFinite;
+		this->Sum += Other.Sum;
+		this->Largest = (Other.Largest > this->Largest) ? Other.Largest : this->Largest;
+		for (int64_t Index = 0; Index < NumBins; Index++)
+		{
+			this->Bins[Index] += Other.Bins[Index];
+		}
+		for (const auto &Pair : Other.OutputMax)
+		{
+			double &OutMax = this->OutputMax[Pair.first];
+			OutMax = (Pair.second > OutMax) ? Pair.second : OutMax;
+		}
+	}
+
+	/**
+	 * @brief Forgets everything seen so far.
+	 */
+	void Clear()
+	{
+		*this = ErrorStatistics();
+	}
+
+	/**
+	 * @brief The number of errors counted, one per output of every run of P.
+	 */
+	uint64_t Count() const
+	{
+		return this->Total;
+	}
+
+	/**
+	 * @brief The number of errors which were exactly zero.
+	 */
+	uint64_t ZeroCount() const
+	{
+		return this->Zeros;
+	}
+
+	/**
+	 * @brief The number of errors which were infinite or NaN.
+	 * @details These are counted in Count(), but not in the mean, the quantiles or the histogram.
+	 */
+	uint64_t NonFiniteCount() const
+	{
+		return this->NonFinite;
+	}
+
+	/**
+	 * @brief The average of every finite error.
+	 */
+	double Mean() const
+	{
+		uint64_t Finite = this->Total - this->NonFinite;
+		return (Finite == 0) ? 0.0 : (this->Sum / Finite);
+	}
+
+	/**
+	 * @brief The largest finite error, rounded to a double.
+	 */
+	double Max() const
+	{
+		return this->Largest;
+	}
+
+	/**
+	 * @brief Estimates a quantile of the finite errors.
+	 * @param Q The quantile to find, between 0 and 1
+	 * @return The midpoint of the bin holding that quantile, or 0 if no finite error has been counted
+	 */
+	double Quantile(double Q) const
+	{
+		uint64_t Finite = this->Total - this->NonFinite;
+		if (Finite == 0)
+		{
+			return 0.0;
+		}
+
+		Q = (Q < 0.0) ? 0.0 : ((Q > 1.0) ? 1.0 : Q);
+		uint64_t Rank = (uint64_t)std::ceil(Q * Finite);
+		Rank = (Rank == 0) ? 1 : Rank;
+
+		uint64_t Seen = this->Zeros;
+		if (Seen >= Rank)
+		{
+			return 0.0;
+		}
+
+		for (int64_t Index = 0; Index < NumBins; Index++)
+		{
+			Seen += this->Bins[Index];
+			if (Seen >= Rank)
+			{
+				double Mid = 0.5 * (LowerOf(Index) + LowerOf(Index + 1));
+				return (Mid < this->Largest) ? Mid : this->Largest;
+			}
+		}
+		return this->Largest;
+	}
+
+	/**
+	 * @brief Estimates the 99th percentile of the finite errors.
+	 */
+	double P99() const
+	{
+		return this->Quantile(0.99);
+	}
+
+	/**
+	 * @brief Lists every bin which has counted at least one error, from smallest to largest.
+	 */
+	std::vector<ErrorBin> Histogram() const
+	{
+		std::vector<ErrorBin> RetVal;
+		for (int64_t Index = 0; Index < NumBins; Index++)
+		{
+			if (this->Bins[Index] != 0)
+			{
+				RetVal.push_back(ErrorBin{LowerOf(Index), LowerOf(Index + 1), this->Bins[Index]});
+			}
+		}
+		return RetVal;
+	}
+
+	/**
+	 * @brief The largest error seen in each output of P, by its key.
+	 * @details An output which has ever had an infinite or NaN error reports infinity.
+	 */
+	const std::unordered_map<uint64_t, double> &OutputMaxima() const
+	{
+		return this->OutputMax;
+	}
+
+private:
+	/* Collectors are sent between processes as they are, bin by bin. */
+	friend class impl::Serializer;
+	friend class impl::Deserializer;
+
+	/* Val must be finite and positive. */
+	static int64_t BinOf(double Val)
+	{
+		/* Val = Frac * 2^Exp, with Frac in [0.5, 1). */
+		int Exp = 0;
+		double Frac = std::frexp(Val, &Exp);
+		int64_t Octave = (int64_t)Exp - 1;
+		if (Octave < MinExp)
+		{
+			return 0;
+		}
+		if (Octave > MaxExp)
+		{
+			return NumBins - 1;
+		}
+		int64_t Sub = (int64_t)((2.0 * Frac - 1.0) * SubBins);
+		Sub = (Sub < 0) ? 0 : ((Sub > SubBins - 1) ? SubBins - 1 : Sub);
+		return (Octave - MinExp) * SubBins + Sub;
+	}
+
+	static double LowerOf(int64_t Index)
+	{
+		int64_t Octave = (Index / SubBins) + MinExp;
+		int64_t Sub = Index % SubBins;
+		return std::ldexp(1.0 + ((double)Sub / SubBins), (int)Octave);
+	}
+
+	uint64_t Total = 0;
+	uint64_t Zeros = 0;
+	uint64_t NonFinite = 0;
+	double Sum = 0.0;
+	double Largest = 0.0;
+	std::vector<uint64_t> Bins;
+	std::unordered_map<uint64_t, double> OutputMax;
+};
+
+}
+
+#endif
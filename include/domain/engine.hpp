@@ -0,0 +1,724 @@
+#include <span>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <iostream>
+
+#include <value.hpp>
+#include <hpfloat.hpp>
+#include <bgrt/bgrt.hpp>
+#include <unordered_map>
+
+#include "impl/stats.hpp"
+#include "impl/incumbent.hpp"
+#include "impl/partition.hpp"
+
+#include "domain/util.hpp"
+#include "domain/policy.hpp"
+#include "domain/control.hpp"
+#include "domain/options.hpp"
+#include "domain/trace.hpp"
+#include "domain/profile.hpp"
+#include "domain/timeline.hpp"
+#include "domain/executor.hpp"
+#include "domain/dependency.hpp"
+#include "domain/distribution.hpp"
+
+#ifndef DOMAIN_ENGINE_HPP_
+#define DOMAIN_ENGINE_HPP_
+
+/**
+ * @file include/domain/engine.hpp
+ * @brief The generic BGRT search loop, shared by every FindError driver
+ */
+
+namespace dom
+{
+
+/**
+ * @brief Implements the BGRT algorithm once, parameterized over policies for how the search proceeds
+ * @details Every generation, the current BGRT state is partitioned into one slice of children per worker of the executor,
+ * filtered, and evaluated. The worst child becomes the new state, and the search may restart from the initial configuration.
+ * Since the policies are template parameters, composing them costs nothing at runtime.
+ *
+ * @param T The low-precision floating point type under test
+ * @param Stop The stopping policy, as in Stop.Done(SearchState). Workers also ask it before every batch, with the running totals of the
+ * current generation included, so Done must be safe to call from several threads at once.
+ * @param Filter The filtering policy, as in Filter(Configuration), returning whether a child should be evaluated
+ * @param Restart The restart policy, as in Restart(Generator), returning whether to go back to the initial configuration
+ * @param Executor The executor which evaluates each generation. See domain/executor.hpp
+ * @param Split The splitting policy, which may bias how BGRT partitions variables, as in Split.Begin(F, BGRT, InitConf) once before the
+ * search, and Split.Update(BGRT, Parent, Children) after every generation, with the state it started from and the error of every child.
+ * @author Brian Schnepp
+ * @see https://formalverification.cs.utah.edu/grt/publications/ppopp14-s3fp.pdf
+ */
+template<typename T, typename Stop, typename Filter, typename Restart, typename Executor, typename Split = UniformSplit>
+class SearchEngine
+{
+public:
+	using Var = bgrt::Variable<T>;
+	using Configuration = std::unordered_map<uint64_t, Var>;
+	using Array = std::unordered_map<uint64_t, dom::Value<T>>;
+	using Function = Array (*)(Array&);
+
+	/* Don't allow using something of the same size as the high precision float. */
+	static_assert(sizeof(T) != sizeof(dom::hpfloat));
+
+	/**
+	 * @brief Sets up a search over a given function.
+	 * @param F The function which takes a BGRT configuration to check for floating-point error with.
+	 * @param Exec The executor to evaluate configurations with. It must outlive the engine.
+	 * @param Halt The stopping policy
+	 * @param Accept The filtering policy
+	 * @param Reset The restart policy
+	 * @param Iterations The number of configurations to create upon every previous configuration given
+	 * @param k The number of times to execute F, looking for potential error
+	 * @param LogFreq Chance (out of 10000) that a log is printed after any given generation.
+	 * @param LogOut A stream to send messages to for logging.
+	 */
+	SearchEngine(Function F, Executor &Exec, Stop Halt, Filter Accept, Restart Reset,
+		uint64_t Iterations = 100, uint64_t k = 1000, uint64_t LogFreq = 5000, std::ostream &LogOut = std::cout)
+		: F(F), Exec(Exec), Halt(Halt), Accept(Accept), Reset(Reset),
+		  Iterations(Iterations), k(k), LogFreq(LogFreq), LogOut(LogOut), Gen(std::random_device{}()), Stats(Exec.Workers()),
+		  Outcomes(Exec.Workers())
+	{
+	}
+
+	/**
+	 * @brief Runs the search until the stopping policy says to, or the cancellation token expires.
+	 * @param Init The initial BGRT variable configuration
+	 * @return The highest error of the function that was ever found, described as "WorstError" in the paper
+	 */
+	EvalResults Run(const Configuration &Init)
+	{
+		/* Leave out any inputs which can't affect the outputs: they would only make every split less effective. */
+		this->Deps = DependencyReport{};
+		Configuration InitConf = Init;
+		if (this->ProbeSamples != 0)
+		{
+			this->Deps = dom::Dependencies(this->F, Init, this->ProbeSamples);
+			InitConf = DropUnused(Init, this->Deps);
+		}
+
+		/* Refer to the paper for precise meanings of these values */
+		EvalResults WorstError = EvalResults{};
+		EvalResults LocalError = EvalResults{};
+
+		Configuration LocalConf = InitConf;
+		bgrt::BGRTState<T> BGRT(LocalConf);
+		this->Guide.Begin(this->F, BGRT, InitConf);
+
+		this->State = SearchState{};
+		for (impl::ThreadStats &S : this->Stats)
+		{
+			S.Reset();
+		}
+		this->Distributions = std::vector<ErrorStatistics>((this->Distribution != nullptr) ? this->Stats.size() : 0);
+		this->TraceBusy.assign(this->Stats.size(), 0);
+		this->Profiled = SearchProfile{};
+		this->Profiled.Enabled = impl::Profiling;
+		this->WorkerPhases.assign(this->Stats.size(), PhaseProfile{});
+		this->Counts.assign(this->Stats.size(), SliceCount{});
+		PhaseProfile Waiting{};
+		const uint64_t Coordinator = (this->Timeline != nullptr) ? this->Timeline->Coordinator() : 0;
+		bool FromInit = true;
+
+		const uint64_t NumWorkers = this->Exec.Workers();
+		std::vector<std::vector<Configuration>> PartNextConfs(NumWorkers);
+		std::vector<impl::WorkerResult<T>> Results(NumWorkers);
+
+		EvalJob Job{this};
+		const auto Start = std::chrono::steady_clock::now();
+
+		std::uniform_int_distribution<int> Dist(0, 100);
+		while (!this->Halt.Done(this->State) && !Job.Stopped())
+		{
+			LocalError = EvalResults{};
+			const uint64_t EvaluatedBefore = this->State.Evaluated;
+
+			/* Create a partition of all the configurations possible from the current BGRT state, one slice per worker,
+			 * dropping anything the filter doesn't want. The executor decides which thread makes each slice.
+			 */
+			for (SliceCount &Count : this->Counts)
+			{
+				Count.Generated = 0;
+				Count.Accepted = 0;
+			}
+			auto Produce = [this, NumWorkers, &BGRT](uint64_t TID, std::vector<Configuration> &Slice)
+			{
+				SliceCount &Count = this->Counts[TID];
+				const PhaseProfile FilterBefore = Count.FilterProfile;
+				impl::ScopedPhase Generating(Count.GenerateProfile);
+				dom::impl::PartitionSlice<T>(TID, NumWorkers, this->Iterations, BGRT, [this, &Count](const Configuration &Config)
+				{
+					impl::ScopedPhase Filtering(Count.FilterProfile);
+					bool Okay = this->Accept(Config);
+					Filtering.Stop();
+					Count.Generated++;
+					Count.Accepted += (1 * Okay);
+					return Okay;
+				}, Slice);
+				Generating.Stop();
+				if constexpr (impl::Profiling)
+				{
+					impl::Exclude(Count.GenerateProfile, Count.FilterProfile, FilterBefore);
+				}
+			};
+
+			impl::TimelineSpan GenerateSpan(this->Timeline, Coordinator, "Generate");
+			this->Exec.Generate(PartNextConfs, Produce);
+			uint64_t Generated = 0;
+			uint64_t Accepted = 0;
+			for (const SliceCount &Count : this->Counts)
+			{
+				Generated += Count.Generated;
+				Accepted += Count.Accepted;
+			}
+			GenerateSpan.Stop(Accepted);
+			this->State.Generated = Generated;
+			this->State.Accepted = Accepted;
+
+			/* We're done if every possible job was too close to the boundary. */
+			if (this->Halt.Done(this->State))
+			{
+				break;
+			}
+
+			this->Best.Reset(this->State.Generation);
+			impl::ScopedPhase Executing(Waiting);
+			impl::TimelineSpan WaitSpan(this->Timeline, Coordinator, "Wait");
+			this->Exec.Execute(PartNextConfs, Results, Job);
+			WaitSpan.Stop();
+			Executing.Stop();
+
+			/* The executor has joined its workers, so the counters are exact now. */
+			impl::ScopedPhase Reducing(this->Profiled.Reduce);
+			impl::TimelineSpan ReduceSpan(this->Timeline, Coordinator, "Reduce");
+			this->Tally();
+
+			/* Let the splitting policy learn from every child, before the state moves on from their parent. */
+			this->Children.clear();
+			for (std::vector<SplitOutcome<T>> &Seen : this->Outcomes)
+			{
+				this->Children.insert(this->Children.end(), Seen.begin(), Seen.end());
+				Seen.clear();
+			}
+			this->Guide.Update(BGRT, LocalConf, this->Children);
+
+			/* Reduce the slices in order: the first worker with the highest error wins. */
+			for (uint64_t TID = 0; TID < NumWorkers; TID++)
+			{
+				if (Results[TID].Best.Err > LocalError.Err)
+				{
+					LocalError = Results[TID].Best;
+					LocalConf = Results[TID].Conf;
+				}
+			}
+
+			if (LocalError.Err > 0)
+			{
+				BGRT.SetVals(LocalConf);
+			}
+
+			/* Is the error in this configuration higher than the global maximum? */
+			if (LocalError.Err > WorstError.Err)
+			{
+				WorstError = LocalError;
+			}
+
+			const double GenerationBest = mpfr_get_d(LocalError.Err.mpfr_srcptr(), MPFR_RNDN);
+
+			/* Searches elsewhere (such as on other MPI ranks) may have found a better state to continue from, or may
+			 * take part of this one, in which case restarts only go back to what is left.
+			 */
+			const bool Adopted = this->Exec.Share(LocalError, LocalConf, InitConf, this->Accept);
+			if (Adopted)
+			{
+				BGRT.SetVals(LocalConf);
+			}
+			ReduceSpan.Stop();
+			Reducing.Stop();
+
+			if (this->Trace != nullptr)
+			{
+				this->RecordTrace(GenerationBest, WorstError, this->State.Evaluated - EvaluatedBefore,
+					(FromInit ? (uint64_t)TRACE_FROM_INITIAL : 0) | (Adopted ? (uint64_t)TRACE_ADOPTED : 0), Start);
+				FromInit = false;
+			}
+			this->State.Generation++;
+
+			if (this->Progress != nullptr)
+			{
+				this->Publish(WorstError, Start);
+			}
+
+			/* If we ran out of time, whatever was found so far is the answer, even if the generation was cut short. */
+			if (Job.Stopped())
+			{
+				break;
+			}
+
+			/* Also sometimes send something to LogOut, this is just to confirm liveness and also show how much progress we're making. */
+			if ((uint64_t)(Dist(this->Gen) * Dist(this->Gen)) <= this->LogFreq)
+			{
+				this->LogOut << "(CurError " << "(abs " << WorstError.Err << ")" << ", (rel " << WorstError.RelErr << "))" << std::endl;
+			}
+
+			/* Sometimes re-issue the original configuration, to avoid getting stuck. */
+			if (this->Reset(this->Gen))
+			{
+				LocalConf = InitConf;
+				BGRT.SetVals(LocalConf);
+				FromInit = true;
+			}
+		}
+
+		for (const ErrorStatistics &Dist : this->Distributions)
+		{
+			this->Distribution->Merge(Dist);
+		}
+		if constexpr (impl::Profiling)
+		{
+			this->Summarize(Waiting);
+		}
+
+		impl::TimelineSpan FinishSpan(this->Timeline, Coordinator, "Finish");
+		this->Exec.Finish(WorstError);
+		FinishSpan.Stop();
+		if (this->Timeline != nullptr)
+		{
+			this->Timeline->Write();
+		}
+		return WorstError;
+	}
+
+	/**
+	 * @brief Runs the search with the token, progress channel, statistics and input probe of a set of options.
+	 * @details These stay set for later searches, as if given to their setters. The profile is written once the search is over.
+	 * Options which belong to the executor (NumThreads, PinThreads) or to a driver (BoxesPerRank) are ignored.
+	 * @param Init The initial BGRT variable configuration
+	 * @param Options The options to run with
+	 * @return The highest error of the function that was ever found, described as "WorstError" in the paper
+	 */
+	EvalResults Run(const Configuration &Init, const SearchOptions &Options)
+	{
+		this->SetCancellationToken(Options.Token);
+		this->SetProgress(Options.Progress);
+		this->SetStatistics(Options.Distribution);
+		this->SetInputProbe(Options.ProbeSamples);
+		EvalResults RetVal = this->Run(Init);
+		if (Options.Profile != nullptr)
+		{
+			*Options.Profile = this->Profiled;
+		}
+		return RetVal;
+	}
+
+	/**
+	 * @brief Lets the search be stopped early through a token, either by cancellation or a deadline.
+	 * @param Token The token to poll while sampling, which must outlive the search. nullptr (default) disables this.
+	 */
+	void SetCancellationToken(const CancellationToken *Token)
+	{
+		this->Token = Token;
+	}
+
+	/**
+	 * @brief Publishes the progress of the search through a lock-free channel, once per generation.
+	 * @param Progress The channel to publish to, which must outlive the search. nullptr (default) disables this.
+	 */
+	void SetProgress(SearchProgress *Progress)
+	{
+		this->Progress = Progress;
+	}
+
+	/**
+	 * @brief Records every generation of the search to a trace file, including how long each worker spent evaluating.
+	 * @param Trace The recorder to append to, which must outlive the search. nullptr (default) disables this.
+	 */
+	void SetTrace(TraceRecorder *Trace)
+	{
+		this->Trace = Trace;
+	}
+
+	/**
+	 * @brief Records when each worker evaluated each batch, and when the coordinator made, waited on, and reduced each generation,
+	 * to be written out as a Chrome trace once the search is over.
+	 * @details With MPI, every rank runs its own engine and writes its own timeline, so each rank must be given a recorder
+	 * with a path of its own (such as one with the rank in it). Ranks writing to the same path overwrite each other.
+	 * Workers in other processes (see ProcessExecutor) send when they evaluated each batch back with its results, and are
+	 * recorded here, in their own lanes.
+	 * @param Timeline The recorder to record to, which must outlive the search. nullptr (default) disables this.
+	 * @return Whether the timeline will be recorded to. A recorder without a lane for every worker of the executor is refused,
+	 * since those workers would record into the coordinator's lane, or none at all; the search then isn't recorded.
+	 */
+	bool SetTimeline(TimelineRecorder *Timeline)
+	{
+		this->Timeline = (Timeline != nullptr && Timeline->Coordinator() >= this->Exec.Workers()) ? Timeline : nullptr;
+		return this->Timeline == Timeline;
+	}
+
+	/**
+	 * @brief Collects the distribution of every error the search sees, not only the worst one.
+	 * @details Each worker counts into its own collector, and they are all added to Out once Run finishes.
+	 * @param Out Where to add the distribution to, which must outlive the search. nullptr (default) disables this.
+	 */
+	void SetStatistics(ErrorStatistics *Out)
+	{
+		this->Distribution = Out;
+	}
+
+	/**
+	 * @brief Lets workers give up on a configuration early, once it's clearly not going to be the worst one of its generation.
+	 * @details Every worker offers its results to a shared incumbent as soon as they are computed. A configuration is abandoned
+	 * once at least a quarter of its k samples are done, if its error so far, multiplied by Factor, is still below the incumbent.
+	 * This saves shadow operations, at the cost of sometimes missing a configuration whose error is in its last few samples.
+	 * @param Factor How far below the incumbent a configuration must be to be abandoned. 0 (default) disables this.
+	 */
+	void SetPruneFactor(double Factor)
+	{
+		this->PruneFactor = Factor;
+	}
+
+	/**
+	 * @brief Probes F before every search for inputs which never reach an output (or a comparison), and leaves them out of it.
+	 * @details Inputs which are left out are no longer given to F at all. This is only safe if F does all its work on them as
+	 * Values: anything done after converting an input to a plain number is invisible to the probe. See dom::Dependencies.
+	 * @param Samples How many times to run F while probing. 0 (default) disables this, and every input is searched.
+	 */
+	void SetInputProbe(uint64_t Samples)
+	{
+		this->ProbeSamples = Samples;
+	}
+
+	/**
+	 * @brief Obtains which inputs the most recent search found to be used. This is empty unless probing is enabled.
+	 */
+	const DependencyReport &Dependencies() const
+	{
+		return this->Deps;
+	}
+
+	/**
+	 * @brief Replaces the splitting policy, such as to tune its parameters.
+	 * @param Guide The splitting policy to use in the next search
+	 */
+	void SetSplit(const Split &Guide)
+	{
+		this->Guide = Guide;
+	}
+
+	/**
+	 * @brief Obtains the splitting policy, such as to inspect what it learned during the last search.
+	 */
+	const Split &Splitter() const
+	{
+		return this->Guide;
+	}
+
+	/**
+	 * @brief Reads the worst configuration of the current generation found by any worker so far. This may be called from any thread.
+	 */
+	impl::IncumbentRecord CurrentBest() const
+	{
+		return this->Best.Read();
+	}
+
+	/**
+	 * @brief Reads how much work each worker has done in the current (or most recent) search. This may be called from any thread.
+	 */
+	std::vector<impl::ThreadStatsSnapshot> ThreadStatistics() const
+	{
+		std::vector<impl::ThreadStatsSnapshot> RetVal;
+		for (const impl::ThreadStats &S : this->Stats)
+		{
+			RetVal.push_back(S.Read());
+		}
+		return RetVal;
+	}
+
+	/**
+	 * @brief Obtains where the most recent search spent its time and allocations. Every field is 0 unless libdomain is built
+	 * with DOMAIN_PROFILE. This is only safe to call once Run has returned.
+	 */
+	const SearchProfile &Profile() const
+	{
+		return this->Profiled;
+	}
+
+	/**
+	 * @brief Obtains the progress of the current (or most recent) search. This is only safe to call from the thread running it.
+	 */
+	const SearchState &Status() const
+	{
+		return this->State;
+	}
+
+private:
+	/**
+	 * @brief What was made for one slice of the current generation, by whichever thread made it. Each is on its own cache
+	 * line, since pinned workers make their slices at the same time.
+	 */
+	struct alignas(64) SliceCount
+	{
+		uint64_t Generated;
+		uint64_t Accepted;
+
+		/* Summed over the whole search, and only measured when profiling */
+		PhaseProfile GenerateProfile;
+		PhaseProfile FilterProfile;
+	};
+
+	/**
+	 * @brief The work done by an executor for each configuration.
+	 */
+	struct EvalJob
+	{
+		SearchEngine *Engine;
+
+		void operator()(uint64_t TID, std::span<const Configuration> Batch, std::vector<EvalResults> &Out) const
+		{
+			PhaseProfile Spent{};
+			std::chrono::steady_clock::time_point Began;
+			this->Eval(TID, Batch, Out, Spent, Began);
+			this->Busy(TID, Batch.size(), Spent, Began);
+			this->Record(TID, Batch, Out);
+		}
+
+		/**
+		 * @brief Evaluates a batch, without any of the bookkeeping operator() does afterwards.
+		 * @param Spent Set to the time (and allocations) spent, if anything uses it (see Timed). Left alone otherwise.
+		 * @param Began Set to when evaluating began, if Spent is
+		 */
+		void Eval(uint64_t TID, std::span<const Configuration> Batch, std::vector<EvalResults> &Out, PhaseProfile &Spent,
+			std::chrono::steady_clock::time_point &Began) const
+		{
+			SearchEngine *Self = this->Engine;
+			ErrorStatistics *Dist = this->Distribution(TID);
+
+			/* Stop sampling once the search is over, or (if pruning) once it's clear the configuration won't win. */
+			auto Abandon = [Self](const dom::hpfloat &Err, uint64_t Samples)
+			{
+				if (Self->PruneFactor > 0 && (Samples * 4 >= Self->k)
+					&& (mpfr_get_d(Err.mpfr_srcptr(), MPFR_RNDU) * Self->PruneFactor < Self->Best.Bound()))
+				{
+					return true;
+				}
+				return Self->Token != nullptr && Self->Token->Expired();
+			};
+			if (this->Timed())
+			{
+				impl::PhaseTimer Timer(Spent);
+				Began = Timer.Began();
+				EvalBatch(Self->F, Batch, Self->k, Out, Abandon, Dist);
+			}
+			else
+			{
+				EvalBatch(Self->F, Batch, Self->k, Out, Abandon, Dist);
+			}
+		}
+
+		/**
+		 * @brief Whether workers are timed. They only are when tracing, recording a timeline, or profiling, since reading
+		 * the clock around every batch isn't free.
+		 */
+		bool Timed() const
+		{
+			SearchEngine *Self = this->Engine;
+			return Self->Trace != nullptr || Self->Timeline != nullptr || impl::Profiling;
+		}
+
+		/**
+		 * @brief Counts the time a worker spent evaluating a batch, possibly somewhere else (such as in another process): in
+		 * its busy time, the profile, and the timeline. Nothing is counted unless workers are timed.
+		 * @param Count The number of configurations in the batch
+		 * @param Spent The time (and allocations) spent evaluating it, as measured by Eval
+		 * @param Began When evaluating it began, as measured by Eval
+		 */
+		void Busy(uint64_t TID, uint64_t Count, const PhaseProfile &Spent, std::chrono::steady_clock::time_point Began) const
+		{
+			SearchEngine *Self = this->Engine;
+			if (!this->Timed())
+			{
+				return;
+			}
+			Self->Stats[TID].AddBusy(Spent.Nanos);
+			impl::Accumulate(Self->WorkerPhases[TID], Spent);
+			if (Self->Timeline != nullptr)
+			{
+				Self->Timeline->Record(TID, "Eval", Began, Began + std::chrono::nanoseconds(Spent.Nanos), Count);
+			}
+		}
+
+		/**
+		 * @brief Does the bookkeeping for a batch which has already been evaluated, possibly somewhere else (such as in
+		 * another process): this is everything operator() does after evaluating.
+		 */
+		void Record(uint64_t TID, std::span<const Configuration> Batch, const std::vector<EvalResults> &Out) const
+		{
+			SearchEngine *Self = this->Engine;
+			for (const EvalResults &Res : Out)
+			{
+				/* Let everyone else know as soon as something better is found. */
+				Self->Best.Offer(Res.Err, Res.RelErr, TID);
+				Self->Stats[TID].Record(Res.TotalShadowOps, Res.Samples);
+			}
+			for (uint64_t Index = 0; Index < Batch.size(); Index++)
+			{
+				Self->Outcomes[TID].push_back(SplitOutcome<T>{&Batch[Index], mpfr_get_d(Out[Index].Err.mpfr_srcptr(), MPFR_RNDN)});
+			}
+		}
+
+		/**
+		 * @brief Where a worker counts the errors it sees, or nullptr if the distribution isn't being collected.
+		 */
+		ErrorStatistics *Distribution(uint64_t TID) const
+		{
+			SearchEngine *Self = this->Engine;
+			return (Self->Distribution != nullptr) ? &Self->Distributions[TID] : nullptr;
+		}
+
+		/**
+		 * @brief Drops what a worker kept from its earlier slices, for a worker with its own copy of the search (such as
+		 * a worker process): its children, its errors already sent on, and the incumbent it prunes against.
+		 */
+		void Forget(uint64_t TID) const
+		{
+			SearchEngine *Self = this->Engine;
+			Self->Outcomes[TID].clear();
+			Self->Best.Reset(Self->State.Generation);
+			if (Self->Distribution != nullptr)
+			{
+				Self->Distributions[TID].Clear();
+			}
+		}
+
+		bool Stopped() const
+		{
+			SearchEngine *Self = this->Engine;
+			if (Self->Token != nullptr && Self->Token->Expired())
+			{
+				return true;
+			}
+
+			/* Check the stopping policy against what every worker has done so far, rather than waiting for the generation to end. */
+			SearchState Live = Self->State;
+			impl::ThreadStatsSnapshot Sum = impl::SumStats(Self->Stats);
+			Live.ShadowOps = Sum.ShadowOps;
+			Live.Evaluated = Sum.Configs;
+			Live.Samples = Sum.Samples;
+			return Self->Halt.Done(Live);
+		}
+	};
+
+	/**
+	 * @brief Brings the running totals up to date with the per-thread counters.
+	 */
+	void Tally()
+	{
+		impl::ThreadStatsSnapshot Sum = impl::SumStats(this->Stats);
+		this->State.ShadowOps = Sum.ShadowOps;
+		this->State.Evaluated = Sum.Configs;
+		this->State.Samples = Sum.Samples;
+	}
+
+	/**
+	 * @brief Fills in the parts of the profile which come from the workers, once the search is over.
+	 * @param Waiting How long the coordinator spent waiting on the executor, over every generation
+	 */
+	void Summarize(const PhaseProfile &Waiting)
+	{
+		this->Profiled.Generations = this->State.Generation;
+		for (const PhaseProfile &Worker : this->WorkerPhases)
+		{
+			impl::Accumulate(this->Profiled.Eval, Worker);
+		}
+		for (const SliceCount &Count : this->Counts)
+		{
+			impl::Accumulate(this->Profiled.Generate, Count.GenerateProfile);
+			impl::Accumulate(this->Profiled.Filter, Count.FilterProfile);
+		}
+
+		/* Every worker was available for as long as the coordinator waited, so whatever they didn't spend evaluating was idle. */
+		const uint64_t Available = Waiting.Nanos * this->WorkerPhases.size();
+		this->Profiled.Idle = (Available > this->Profiled.Eval.Nanos) ? (Available - this->Profiled.Eval.Nanos) : 0;
+	}
+
+	void RecordTrace(double GenerationBest, const EvalResults &WorstError, uint64_t Evaluated, uint64_t Flags,
+		std::chrono::steady_clock::time_point Start)
+	{
+		const std::chrono::nanoseconds Elapsed = std::chrono::steady_clock::now() - Start;
+
+		TraceRecord Rec;
+		Rec.Time = (uint64_t)Elapsed.count();
+		Rec.Generation = this->State.Generation;
+		Rec.Generated = this->State.Generated;
+		Rec.Accepted = this->State.Accepted;
+		Rec.Evaluated = Evaluated;
+		Rec.ShadowOps = this->State.ShadowOps;
+		Rec.LocalBest = GenerationBest;
+		Rec.GlobalBest = mpfr_get_d(WorstError.Err.mpfr_srcptr(), MPFR_RNDN);
+		Rec.Flags = Flags;
+
+		/* The counters are running totals, so each worker's time in this generation is how much they grew. */
+		std::vector<uint64_t> Busy(this->Stats.size());
+		for (uint64_t TID = 0; TID < this->Stats.size(); TID++)
+		{
+			const uint64_t Total = this->Stats[TID].Read().Busy;
+			Busy[TID] = Total - this->TraceBusy[TID];
+			this->TraceBusy[TID] = Total;
+		}
+		this->Trace->Append(Rec, Busy);
+	}
+
+	void Publish(const EvalResults &WorstError, std::chrono::steady_clock::time_point Start)
+	{
+		std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+
+		ProgressSnapshot Snap;
+		Snap.WorstError = (double)WorstError.Err;
+		Snap.Generations = this->State.Generation;
+		Snap.ShadowOps = this->State.ShadowOps;
+		Snap.Samples = this->State.Samples;
+		Snap.SamplesPerSecond = (Elapsed.count() > 0) ? (Snap.Samples / Elapsed.count()) : 0.0;
+		this->Progress->Publish(Snap);
+	}
+
+	Function F;
+	Executor &Exec;
+	const CancellationToken *Token = nullptr;
+	SearchProgress *Progress = nullptr;
+	TraceRecorder *Trace = nullptr;
+	TimelineRecorder *Timeline = nullptr;
+	double PruneFactor = 0.0;
+	uint64_t ProbeSamples = 0;
+	ErrorStatistics *Distribution = nullptr;
+
+	[[no_unique_address]] Stop Halt;
+	[[no_unique_address]] Filter Accept;
+	[[no_unique_address]] Restart Reset;
+	[[no_unique_address]] Split Guide;
+
+	uint64_t Iterations;
+	uint64_t k;
+	uint64_t LogFreq;
+	std::ostream &LogOut;
+
+	std::mt19937 Gen;
+	SearchState State;
+	impl::Incumbent Best;
+	std::vector<impl::ThreadStats> Stats;
+	std::vector<ErrorStatistics> Distributions;
+	std::vector<uint64_t> TraceBusy;
+	SearchProfile Profiled{};
+	std::vector<PhaseProfile> WorkerPhases;
+	std::vector<SliceCount> Counts;
+	DependencyReport Deps;
+	std::vector<std::vector<SplitOutcome<T>>> Outcomes;
+	std::vector<SplitOutcome<T>> Children;
+};
+
+}
+
+#endif
@@ -0,0 +1,335 @@
+#include <span>
+#include <vector>
+#include <cstdint>
+
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include <value.hpp>
+#include <hpfloat.hpp>
+#include <bgrt/bgrt.hpp>
+#include <unordered_map>
+
+#include "impl/affinity.hpp"
+#include "domain/util.hpp"
+
+#ifndef DOMAIN_EXECUTOR_HPP_
+#define DOMAIN_EXECUTOR_HPP_
+
+/**
+ * @file include/domain/executor.hpp
+ * @brief Executors, which decide where the configurations of each generation are evaluated
+ *
+ * An executor provides:
+ *  - Workers(), the number of slices a generation is partitioned into
+ *  - Generate(Parts, Produce), which empties every slice of Parts and refills it with Produce(TID, Slice). Produce may be
+ *    called for several slices at once, from any thread.
+ *  - Execute(Parts, Results, Job), which runs Job over every batch of configurations of every slice, and returns
+ *    once each slice's summary has been written to Results. A slice is cut short once Job.Stopped() is true.
+ *    Executors which evaluate a batch somewhere Job's side effects can't be seen must instead evaluate it there with
+ *    Job.Eval(TID, Batch, Results, Spent, Began), and then, on the calling process, pass the time it took to
+ *    Job.Busy(TID, Count, Spent, Began) and its results to Job.Record(TID, Batch, Results), and merge whatever the worker
+ *    added to Job.Distribution(TID) (an ErrorStatistics, or nullptr if not collecting) into the calling process's.
+ *    Executors whose workers keep their own copy of Job from one slice to the next must call Job.Forget(TID) there
+ *    before each slice, so that nothing the worker learned in earlier generations is used in this one.
+ *  - Share(LocalError, LocalConf, Base, Accept), which is called after every generation with the state the search will
+ *    continue from, and the state it restarts from (which LocalConf is within). It may replace LocalConf with a better one
+ *    found elsewhere, or give part of Base away to be searched elsewhere, shrinking Base and LocalConf to whatever is kept.
+ *    It returns true if LocalConf changed. Anything given away or kept should pass Accept, the filtering policy.
+ *  - Finish(WorstError), which is called once the search ends, so that results from elsewhere can be combined.
+ */
+
+namespace dom
+{
+
+namespace impl
+{
+
+/**
+ * @brief The summary of one worker's slice of a generation
+ */
+template<typename T>
+struct WorkerResult
+{
+	/* The worst configuration of the slice, and its results */
+	EvalResults Best;
+	std::unordered_map<uint64_t, bgrt::Variable<T>> Conf;
+};
+
+/**
+ * @brief How many configurations a worker evaluates at once. Each batch is checked for cancellation before it starts.
+ */
+constexpr uint64_t BatchSize = 8;
+
+/**
+ * @brief Evaluates the rest of a slice of configurations in batches, keeping only the worst one.
+ * @details This is the hot loop of every executor, so improvements here apply to all of them.
+ * The job is asked whether the search was stopped before each batch, so the slice may be only partially evaluated.
+ * @author Brian Schnepp
+ * @param TID The ID of the worker doing the evaluation
+ * @param Slice The configurations to evaluate
+ * @param From The first configuration of Slice to evaluate. Those before it are left alone.
+ * @param Out The summary of the slice so far, which is replaced by any configuration with a higher error
+ * @param Evaluate The job to run for each batch, as Evaluate(TID, std::span<const Configuration>, std::vector<EvalResults>&),
+ * which writes one result per configuration, and Evaluate.Stopped() -> bool
+ */
+template<typename T, typename Job>
+void RunRange(uint64_t TID, const std::vector<std::unordered_map<uint64_t, bgrt::Variable<T>>> &Slice, uint64_t From,
+	WorkerResult<T> &Out, Job &Evaluate)
+{
+	using Configuration = std::unordered_map<uint64_t, bgrt::Variable<T>>;
+
+	std::vector<EvalResults> Batch;
+	for (uint64_t Begin = From; Begin < Slice.size(); Begin += BatchSize)
+	{
+		if (Evaluate.Stopped())
+		{
+			break;
+		}
+
+		uint64_t Count = (Slice.size() - Begin < BatchSize) ? (Slice.size() - Begin) : BatchSize;
+		Evaluate(TID, std::span<const Configuration>(Slice.data() + Begin, Count), Batch);
+		for (uint64_t Index = 0; Index < Count; Index++)
+		{
+			if (Batch[Index].Err > Out.Best.Err)
+			{
+				Out.Best = Batch[Index];
+				Out.Conf = Slice[Begin + Index];
+			}
+		}
+	}
+}
+
+/**
+ * @brief Evaluates a whole slice of configurations, as RunRange does, writing its summary to Out.
+ */
+template<typename T, typename Job>
+void RunSlice(uint64_t TID, const std::vector<std::unordered_map<uint64_t, bgrt::Variable<T>>> &Slice,
+	WorkerResult<T> &Out, Job &Evaluate)
+{
+	Out.Best = EvalResults{};
+	Out.Conf.clear();
+	RunRange<T>(TID, Slice, 0, Out, Evaluate);
+}
+}
+
+/**
+ * @brief Evaluates every configuration on the calling thread.
+ */
+template<typename T>
+class SerialExecutor
+{
+public:
+	using Configuration = std::unordered_map<uint64_t, bgrt::Variable<T>>;
+
+	uint64_t Workers() const
+	{
+		return 1;
+	}
+
+	template<typename ProduceFn>
+	void Generate(std::vector<std::vector<Configuration>> &Parts, ProduceFn &Produce)
+	{
+		Parts[0].clear();
+		Produce(0, Parts[0]);
+	}
+
+	template<typename Job>
+	void Execute(const std::vector<std::vector<Configuration>> &Parts, std::vector<impl::WorkerResult<T>> &Results, Job &Evaluate)
+	{
+		impl::RunSlice<T>(0, Parts[0], Results[0], Evaluate);
+	}
+
+	template<typename FilterFn>
+	bool Share(EvalResults &/* LocalError */, Configuration &/* LocalConf */, Configuration &/* Base */,
+		const FilterFn &/* Accept */)
+	{
+		return false;
+	}
+
+	void Finish(EvalResults &/* WorstError */)
+	{
+	}
+};
+
+/**
+ * @brief Evaluates each slice of a generation on its own persistent worker thread.
+ * @details The workers are created once, and then woken up for every generation. The job is type-erased once per
+ * generation (rather than once per configuration), so the per-configuration loop is fully inlined.
+ * The same executor may be reused by several searches, one after the other.
+ */
+template<typename T>
+class ThreadExecutor
+{
+public:
+	using Configuration = std::unordered_map<uint64_t, bgrt::Variable<T>>;
+
+	/**
+	 * @brief Starts the worker threads.
+	 * @details When pinned, each worker also makes its own slice of every generation, so that the configurations it
+	 * evaluates are allocated (and first touched) on its own NUMA node. Otherwise, the calling thread makes every slice.
+	 * @param NumThreads The number of threads to be using for finding error. 0 (default) gets all possible threads.
+	 * @param PinThreads Whether each worker should be pinned to its own CPU, keeping its configurations on the local NUMA node.
+	 */
+	ThreadExecutor(uint64_t NumThreads = 0, bool PinThreads = false)
+	{
+		/* If no count provided, use whatever C++ says the number of threads we have is. */
+		if (NumThreads == 0)
+		{
+			NumThreads = std::thread::hardware_concurrency();
+		}
+		NumThreads = (NumThreads == 0) ? 1 : NumThreads;
+
+		this->PinThreads = PinThreads;
+
+		/* The precision of hpfloat may be per-thread, so the workers use whatever the creating thread does. */
+		const mpfr_prec_t Prec = dom::hpfloat::get_default_prec();
+		const std::vector<uint64_t> CPUs = dom::impl::AllowedCPUs();
+		for (uint64_t TID = 0; TID < NumThreads; TID++)
+		{
+			this->Threads.emplace_back([this, CPUs, Prec](uint64_t TID) { this->Worker(TID, CPUs, Prec); }, TID);
+		}
+	}
+
+	~ThreadExecutor()
+	{
+		{
+			std::lock_guard<std::mutex> Lck(this->Lock);
+			this->Terminate = true;
+		}
+		this->WorkCV.notify_all();
+		for (auto &Thread : this->Threads)
+		{
+			Thread.join();
+		}
+	}
+
+	ThreadExecutor(const ThreadExecutor &Other) = delete;
+	ThreadExecutor &operator=(const ThreadExecutor &Other) = delete;
+
+	uint64_t Workers() const
+	{
+		return this->Threads.size();
+	}
+
+	template<typename ProduceFn>
+	void Generate(std::vector<std::vector<Configuration>> &Parts, ProduceFn &Produce)
+	{
+		auto Task = [&Parts, &Produce](uint64_t TID)
+		{
+			Parts[TID].clear();
+			Produce(TID, Parts[TID]);
+		};
+
+		if (!this->PinThreads)
+		{
+			for (uint64_t TID = 0; TID < Parts.size(); TID++)
+			{
+				Task(TID);
+			}
+			return;
+		}
+
+		this->Dispatch(&Task, [](void *Ctx, uint64_t TID)
+		{
+			(*static_cast<decltype(Task)*>(Ctx))(TID);
+		});
+	}
+
+	template<typename Job>
+	void Execute(const std::vector<std::vector<Configuration>> &Parts, std::vector<impl::WorkerResult<T>> &Results, Job &Evaluate)
+	{
+		auto Task = [&Parts, &Results, &Evaluate](uint64_t TID)
+		{
+			impl::RunSlice<T>(TID, Parts[TID], Results[TID], Evaluate);
+		};
+
+		this->Dispatch(&Task, [](void *Ctx, uint64_t TID)
+		{
+			(*static_cast<decltype(Task)*>(Ctx))(TID);
+		});
+	}
+
+	template<typename FilterFn>
+	bool Share(EvalResults &/* LocalError */, Configuration &/* LocalConf */, Configuration &/* Base */,
+		const FilterFn &/* Accept */)
+	{
+		return false;
+	}
+
+	void Finish(EvalResults &/* WorstError */)
+	{
+	}
+
+private:
+	/**
+	 * @brief Hands a task to every worker, and waits for all of them to complete it.
+	 */
+	void Dispatch(void *Ctx, void (*Fn)(void*, uint64_t))
+	{
+		std::unique_lock<std::mutex> Lck(this->Lock);
+		this->TaskCtx = Ctx;
+		this->TaskFn = Fn;
+		this->Pending = this->Threads.size();
+		this->Epoch++;
+		this->WorkCV.notify_all();
+		this->DoneCV.wait(Lck, [this]() { return this->Pending == 0; });
+	}
+
+	void Worker(uint64_t TID, const std::vector<uint64_t> &CPUs, mpfr_prec_t Prec)
+	{
+		dom::hpfloat::set_default_prec(Prec);
+
+		/* Pin first, so that everything this worker allocates is placed on its own NUMA node. */
+		if (this->PinThreads)
+		{
+			dom::impl::PinWorker(TID, CPUs);
+		}
+
+		uint64_t SeenEpoch = 0;
+		while (true)
+		{
+			void *Ctx = nullptr;
+			void (*Fn)(void*, uint64_t) = nullptr;
+			{
+				std::unique_lock<std::mutex> Lck(this->Lock);
+				this->WorkCV.wait(Lck, [this, SeenEpoch]() { return this->Terminate || this->Epoch != SeenEpoch; });
+				if (this->Terminate)
+				{
+					return;
+				}
+				SeenEpoch = this->Epoch;
+				Ctx = this->TaskCtx;
+				Fn = this->TaskFn;
+			}
+
+			Fn(Ctx, TID);
+
+			/* When done, say we are and then notify the coordinator thread if we're the last one. */
+			std::lock_guard<std::mutex> Lck(this->Lock);
+			if (--this->Pending == 0)
+			{
+				this->DoneCV.notify_one();
+			}
+		}
+	}
+
+	std::vector<std::thread> Threads;
+	bool PinThreads;
+
+	std::mutex Lock;
+	std::condition_variable WorkCV;
+	std::condition_variable DoneCV;
+
+	/* Protected by Lock: the current task, and how many workers have yet to finish it. */
+	uint64_t Epoch = 0;
+	uint64_t Pending = 0;
+	bool Terminate = false;
+	void *TaskCtx = nullptr;
+	void (*TaskFn)(void*, uint64_t) = nullptr;
+};
+
+}
+
+#endif
@@ -1,30 +1,24 @@
-#include <array>
-#include <vector>
-
-#include <float.h>
-#include <stdint.h>
-
 #include <list>
-#include <mutex>
-#include <random>
+#include <vector>
+#include <chrono>
+#include <cstring>
 #include <thread>
-#include <atomic>
+#include <stdint.h>
+#include <iostream>
+#include <unordered_map>
 
 #include <value.hpp>
 #include <hpfloat.hpp>
-
-#include "number.hpp"
-
 #include <bgrt/bgrt.hpp>
-#include <unordered_map>
 
-#include <condition_variable>
-#include "impl/partition.hpp"
+#include "impl/decompose.hpp"
+#include "impl/serialize.hpp"
 
 #include "domain/util.hpp"
-
-#include <domain/base.hpp>
-#include <domain/multithread.hpp>
+#include "domain/policy.hpp"
+#include "domain/options.hpp"
+#include "domain/engine.hpp"
+#include "domain/executor.hpp"
 
 #include <mpi.h>
 
@@ -34,267 +28,836 @@
 namespace dom
 {
 
+namespace impl
+{
+
 /**
- * @brief Implements a multi-threaded variant of the BGRT algorithm to efficiently find floating point errors
+ * @brief Finds the result with the highest error over every rank, as a non-blocking reduction which every rank ends up with.
+ * @details Each rank serializes its result at full precision into a buffer, padded to the size of the largest one, which is
+ * found by a first reduction. The buffers are then combined by MPI_Iallreduce with a user-defined type covering the whole
+ * buffer, and a user-defined operator which keeps whichever of two results has the higher error, so MPI is free to do this
+ * as a tree (or however else it likes) rather than funneling every result through one rank.
+ * Ties are broken by the bytes of the results, so that every rank agrees on the same one.
  * @author Brian Schnepp
- * @see https://formalverification.cs.utah.edu/grt/publications/ppopp14-s3fp.pdf
- * @param InitConf The initial BGRT variable configuration
- * @param Iterations The number of configurations to create upon every previous configuration given
- * @param Resources The number of bits which need to be ignored in the mantissa of range: numbers differing by less than this range are ignored.
- * @param RestartPercent The percentage, as a whole integer, where the initial configuration is reset to avoid local minima
- * @param F The function which takes a BGRT configuration to check for floating-point error with.
- * @param k The number of times to execute F, looking for potential error
- * @param LogFreq Operand to (Resoruces % LogFreq), for when error will be logged to LogOut. Default is 5000.
- * @param LogOut A stream to send messages to for logging. Default is std::cout.
- * @return The highest error of the function that was ever found, described as "WorstError" in the paper
  */
-template<typename T>
-EvalResults FindErrorMantissaMPI(const std::unordered_map<uint64_t, bgrt::Variable<T>> &InitConf,
-		std::unordered_map<uint64_t, dom::Value<T>> (*F)(std::unordered_map<uint64_t, dom::Value<T>>&),
-		const uint64_t Iterations = 100, const int64_t Resources = 0, const uint64_t RestartPercent = 5,
-		uint64_t k = 1000, uint64_t LogFreq = 5000, std::ostream &LogOut = std::cout, uint64_t NumThreads = 0)
+class WorstReduction
 {
-	T Lim = (dom::hpfloat)std::numeric_limits<T>::epsilon();
-	dom::hpfloat hLim = (dom::hpfloat)Lim;
-	/* Provide one extra Resource to account for rounding */
-	dom::hpfloat mLim = hLim * dom::hp::pow(2.0, (Resources-1));
+public:
+	WorstReduction() = default;
 
-	int NumP;
-	MPI_Comm_size(MPI_COMM_WORLD, &NumP);
-	
-	int PID;
-	MPI_Comm_rank(MPI_COMM_WORLD, &PID);
-
-	int64_t MyResources = Resources / NumP;
-	if (PID + 1 == NumP) {
-		MyResources += Resources % NumP;
+	~WorstReduction()
+	{
+		this->Release();
 	}
 
-	uint64_t MyK = k / NumP;
-	if (PID + 1 == NumP) {
-		MyK += k % NumP;
+	WorstReduction(const WorstReduction &Other) = delete;
+	WorstReduction &operator=(const WorstReduction &Other) = delete;
+
+	/**
+	 * @brief Starts the reduction. Every rank of Comm must call this.
+	 * @param Mine The result of this rank
+	 * @param Comm The communicator containing every rank taking part in the search
+	 */
+	void Start(const EvalResults &Mine, MPI_Comm Comm)
+	{
+		this->Comm = Comm;
+
+		impl::Serializer Writer;
+		Writer.Write(Mine);
+		this->Buffer = Writer.Bytes();
+		this->LocalSize = this->Buffer.size();
+
+		MPI_Iallreduce(&this->LocalSize, &this->Size, 1, MPI_UINT64_T, MPI_MAX, this->Comm, &this->Request);
+		this->Phase = ReductionPhase::Sizing;
 	}
 
-	EvalResults MyRes = FindErrorBoundConf(InitConf, F, MyResources, mLim, RestartPercent, MyK, LogFreq, LogOut);
+	/**
+	 * @brief Moves the reduction along as far as it can go without waiting.
+	 * @return Whether the reduction is done
+	 */
+	bool Test()
+	{
+		return this->Advance(false);
+	}
 
-	/* HACK: downcast to double and send that. */
-	struct MPIResult
+	/**
+	 * @brief Waits for the reduction to finish.
+	 * @param Out Where to put the result with the highest error of any rank. It is left alone if the result can't be read.
+	 */
+	void Wait(EvalResults &Out)
 	{
-		double Abs;
-		double Rel;
-		uint64_t Shadow;
-	};
+		this->Advance(true);
 
-	MPIResult Mine;
-	Mine.Abs = (double)MyRes.Err;
-	Mine.Rel = (double)MyRes.RelErr;
-	Mine.Shadow = MyRes.TotalShadowOps;
+		EvalResults Worst;
+		impl::Deserializer Reader(this->Result);
+		if (Reader.Read(Worst))
+		{
+			Out = Worst;
+		}
+	}
 
+private:
+	enum class ReductionPhase
+	{
+		Idle,
+		Sizing,
+		Reducing,
+	};
 
-	if (PID == 0)
+	bool Advance(bool Block)
 	{
-		for (int Index = 1; Index < NumP; Index++)
+		while (this->Phase != ReductionPhase::Idle)
 		{
-			MPIResult Theirs;
-			MPI_Recv(&Theirs.Abs, 1, MPI_DOUBLE, Index, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-			MPI_Recv(&Theirs.Rel, 1, MPI_DOUBLE, Index, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-			MPI_Recv(&Theirs.Shadow, 1, MPI_UNSIGNED_LONG_LONG, Index, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+			int Done = 1;
+			if (Block)
+			{
+				MPI_Wait(&this->Request, MPI_STATUS_IGNORE);
+			}
+			else
+			{
+				MPI_Test(&this->Request, &Done, MPI_STATUS_IGNORE);
+			}
+			if (!Done)
+			{
+				return false;
+			}
 
-			if (Mine.Abs < Theirs.Abs)
+			if (this->Phase == ReductionPhase::Sizing)
+			{
+				this->Buffer.resize(this->Size, 0);
+				this->Result.assign(this->Size, 0);
+				MPI_Type_contiguous((int)this->Size, MPI_BYTE, &this->Type);
+				MPI_Type_commit(&this->Type);
+				MPI_Op_create(&WorstReduction::Keep, 1, &this->Op);
+
+				MPI_Iallreduce(this->Buffer.data(), this->Result.data(), 1, this->Type, this->Op, this->Comm, &this->Request);
+				this->Phase = ReductionPhase::Reducing;
+			}
+			else
 			{
-				Mine = Theirs;
+				this->Release();
+				this->Phase = ReductionPhase::Idle;
 			}
 		}
+		return true;
 	}
-	else
+
+	void Release()
 	{
-		MPI_Send(&Mine.Abs, 1, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD);
-		MPI_Send(&Mine.Rel, 1, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD);
-		MPI_Send(&Mine.Shadow, 1, MPI_UNSIGNED_LONG_LONG, 0, 0, MPI_COMM_WORLD);
+		if (this->Op != MPI_OP_NULL)
+		{
+			MPI_Op_free(&this->Op);
+		}
+		if (this->Type != MPI_DATATYPE_NULL)
+		{
+			MPI_Type_free(&this->Type);
+		}
 	}
-	return {Mine.Abs, Mine.Rel, Mine.Shadow};
+
+	/**
+	 * @brief The reduction operator: for each pair of buffers, keeps the result with the higher error in InOut.
+	 */
+	static void Keep(void *In, void *InOut, int *Len, MPI_Datatype *Type)
+	{
+		int Size = 0;
+		MPI_Type_size(*Type, &Size);
+
+		for (int Index = 0; Index < *Len; Index++)
+		{
+			uint8_t *Left = static_cast<uint8_t*>(In) + ((uint64_t)Index * Size);
+			uint8_t *Right = static_cast<uint8_t*>(InOut) + ((uint64_t)Index * Size);
+
+			EvalResults Theirs;
+			EvalResults Ours;
+			impl::Deserializer LeftReader(Left, Size);
+			impl::Deserializer RightReader(Right, Size);
+			bool LeftOkay = LeftReader.Read(Theirs);
+			bool RightOkay = RightReader.Read(Ours);
+
+			bool TakeLeft = LeftOkay && (!RightOkay || Theirs.Err > Ours.Err
+				|| (Theirs.Err == Ours.Err && std::memcmp(Left, Right, Size) > 0));
+			if (TakeLeft)
+			{
+				std::memcpy(Right, Left, Size);
+			}
+		}
+	}
+
+	MPI_Comm Comm = MPI_COMM_NULL;
+	MPI_Request Request = MPI_REQUEST_NULL;
+	MPI_Datatype Type = MPI_DATATYPE_NULL;
+	MPI_Op Op = MPI_OP_NULL;
+	ReductionPhase Phase = ReductionPhase::Idle;
+
+	uint64_t LocalSize = 0;
+	uint64_t Size = 0;
+	std::vector<uint8_t> Buffer;
+	std::vector<uint8_t> Result;
+};
+
+/**
+ * @brief Combines the results of every rank, so that every rank has the one with the highest error.
+ * @details Every rank must call this. See WorstReduction.
+ * @param WorstError The result of this rank, which is replaced by the highest error of any rank
+ * @param Comm The communicator containing every rank taking part in the search
+ */
+inline void ReduceWorst(EvalResults &WorstError, MPI_Comm Comm)
+{
+	WorstReduction Reduce;
+	Reduce.Start(WorstError, Comm);
+	Reduce.Wait(WorstError);
 }
 
 /**
- * @brief Implements an MPI variant of the BGRT algorithm to efficiently find floating point errors
- * @author Brian Schnepp
- * @see https://formalverification.cs.utah.edu/grt/publications/ppopp14-s3fp.pdf
+ * @brief Has every rank start from the same configuration: rank 0's, without the inputs its probe found unused.
+ * @details The probe samples F at random, so ranks probing on their own may disagree on which inputs to leave out whenever
+ * F branches on its inputs. Instead, only rank 0 probes, and broadcasts what is left. Every rank (rank 0 included) then reads
+ * the configuration back from the same bytes, so they also agree on the order its variables are visited in.
+ * Every rank must call this, with the same ProbeSamples.
  * @param InitConf The initial BGRT variable configuration
- * @param Iterations The number of configurations to create upon every previous configuration given
- * @param Resources The rough limit on the number of floating point computations to perform. Actual executions may exceed this value by a fair amount.
- * @param RestartPercent The percentage, as a whole integer, where the initial configuration is reset to avoid local minima
  * @param F The function which takes a BGRT configuration to check for floating-point error with.
- * @param k The number of times to execute F, looking for potential error
- * @param LogFreq Chance (out of 1000) that a log is printed after any given level of configurations. Default is 4000.
- * @param LogOut A stream to send messages to for logging. Default is std::cout.
- * @param NumThreads The number of threads to be using for finding error. 0 (default) gets all possible threads.
- * @return The highest error of the function that was ever found, described as "WorstError" in the paper
+ * @param ProbeSamples How many times to run F on rank 0, looking for inputs which never affect an output. 0 keeps every input.
+ * @param Comm The communicator containing every rank taking part in the search
+ * @return The configuration every rank should search
  */
 template<typename T>
-EvalResults FindErrorBoundConfMPI(const std::unordered_map<uint64_t, bgrt::Variable<T>> &InitConf,
-		std::unordered_map<uint64_t, dom::Value<T>> (*F)(std::unordered_map<uint64_t, dom::Value<T>>&),
-		const uint64_t Iterations = 1000, const dom::hpfloat MinRange = std::numeric_limits<T>::epsilon(), 
-		const uint64_t RestartPercent = 5, uint64_t k = 25, uint64_t LogFreq = 4000, std::ostream &LogOut = std::cout,
-		uint64_t NumThreads = 0)
+std::unordered_map<uint64_t, bgrt::Variable<T>> AgreeOnInputs(const std::unordered_map<uint64_t, bgrt::Variable<T>> &InitConf,
+	std::unordered_map<uint64_t, dom::Value<T>> (*F)(std::unordered_map<uint64_t, dom::Value<T>>&), uint64_t ProbeSamples,
+	MPI_Comm Comm)
 {
-	/* Don't allow using something of the same size as the high precision float. */
-	static_assert(sizeof(T) != sizeof(dom::hpfloat));
+	int PID;
+	MPI_Comm_rank(Comm, &PID);
 
-	if (NumThreads == 0)
+	Serializer Writer;
+	if (PID == 0)
 	{
-		NumThreads = std::thread::hardware_concurrency();
+		Writer.Write((ProbeSamples != 0) ? dom::DropUnused(InitConf, dom::Dependencies(F, InitConf, ProbeSamples)) : InitConf);
 	}
 
-	bool RandomRestart = false;
-	EvalResults WorstError = EvalResults{};
-	EvalResults LocalError = EvalResults{};
-	
-	using Var = bgrt::Variable<T>;
-	using Configuration = std::unordered_map<uint64_t, Var>;
-	
-	Configuration LocalConf = InitConf;
-	bgrt::BGRTState BGRT(LocalConf);
+	uint64_t Size = Writer.Bytes().size();
+	MPI_Bcast(&Size, 1, MPI_UINT64_T, 0, Comm);
+	std::vector<uint8_t> Bytes = (PID == 0) ? Writer.Bytes() : std::vector<uint8_t>(Size);
+	MPI_Bcast(Bytes.data(), (int)Size, MPI_BYTE, 0, Comm);
 
-	static std::random_device Dev;
-	static std::mt19937 Gen(Dev());
-	static std::uniform_int_distribution<int> Dist(0, 100);
+	/* Every rank reads the same bytes, so either all of them fall back to InitConf or none do. */
+	std::unordered_map<uint64_t, bgrt::Variable<T>> RetVal;
+	Deserializer Reader(Bytes);
+	return Reader.Read(RetVal) ? RetVal : InitConf;
+}
 
-	std::thread Threads[NumThreads];
-	std::vector<std::vector<Configuration>> PartNextConfs(NumThreads);
+/**
+ * @brief The options for the search of each rank, once AgreeOnInputs has already left out whatever the probe found unused.
+ */
+inline SearchOptions Probed(const SearchOptions &Options)
+{
+	SearchOptions RetVal = Options;
+	RetVal.ProbeSamples = 0;
+	return RetVal;
+}
 
-	EvalResults LocalErrors[NumThreads];
-	Configuration LocalConfs[NumThreads];
-	std::atomic_uint8_t Continue[NumThreads];
+}
 
-	enum ThreadControl
+/**
+ * @brief Runs a search on every MPI rank with some inner executor, sharing the best state between ranks as the searches go.
+ * @details Each generation is evaluated by the inner executor, exactly as without MPI. Every few generations, the ranks find
+ * whichever one of them is at the state with the highest error through a MAXLOC reduction, and that rank then broadcasts its
+ * configuration to the others. Any rank whose own state has a lower error by then jumps to it, so that ranks stuck in a poor
+ * region catch up with the best one. Every step of an exchange is non-blocking, and only checked on once per generation,
+ * so no rank waits for slower ones in the middle of its search.
+ *
+ * Once the search on a rank is over, it keeps taking part in exchanges until every rank is done, and then every rank
+ * ends up with the highest error of any of them.
+ */
+template<typename T, typename Inner>
+class MPIExecutor
+{
+public:
+	using Configuration = std::unordered_map<uint64_t, bgrt::Variable<T>>;
+
+	/**
+	 * @param Exec The executor to use within this rank. It must outlive this executor.
+	 * @param Comm The communicator containing every rank taking part in the search
+	 * @param Interval How many generations to run between exchanges. 0 disables them, so every rank searches independently.
+	 */
+	MPIExecutor(Inner &Exec, MPI_Comm Comm = MPI_COMM_WORLD, uint64_t Interval = 4) : Exec(Exec), Comm(Comm), Interval(Interval)
 	{
-		EMPTY = 0,
-		WORKING = 1,
-		WORK_AVAIL = 2,
-		TERMINATE = 3,
-	};
-	
+		MPI_Comm_rank(this->Comm, &this->PID);
+	}
+
+	uint64_t Workers() const
+	{
+		return this->Exec.Workers();
+	}
+
+	template<typename ProduceFn>
+	void Generate(std::vector<std::vector<Configuration>> &Parts, ProduceFn &Produce)
+	{
+		this->Exec.Generate(Parts, Produce);
+	}
 
-	for (uint64_t TID = 0; TID < NumThreads; TID++)
+	template<typename Job>
+	void Execute(const std::vector<std::vector<Configuration>> &Parts, std::vector<impl::WorkerResult<T>> &Results, Job &Evaluate)
 	{
-		Continue[TID] = EMPTY;
-		Threads[TID] = std::thread([&LocalErrors, &LocalConfs, &PartNextConfs, &F, &k, &Continue](uint64_t TID)
+		this->Exec.Execute(Parts, Results, Evaluate);
+	}
+
+	template<typename FilterFn>
+	bool Share(EvalResults &LocalError, Configuration &LocalConf, Configuration &Base, const FilterFn &Accept)
+	{
+		bool Adopted = this->Exec.Share(LocalError, LocalConf, Base, Accept);
+		if (this->Interval == 0)
+		{
+			return Adopted;
+		}
+
+		if (this->Phase == ExchangePhase::Idle)
 		{
-			while (Continue[TID] != TERMINATE)
+			if (++this->Generations % this->Interval == 0)
 			{
-				if (Continue[TID] == WORK_AVAIL) 
-				{
-					Continue[TID] = WORKING;
-					for (const auto &C : PartNextConfs[TID])
-					{
-						EvalResults Res = Eval(F, C, k);
-						dom::hpfloat Err = Res.Err;
-						if (Err > LocalErrors[TID].Err)
-						{
-							LocalErrors[TID] = Res;
-							LocalConfs[TID] = C;
-						}
-					}
-					Continue[TID] = EMPTY;
-				}
+				this->Begin(LocalError, LocalConf, true);
 			}
-		}, TID);
+			return Adopted;
+		}
+
+		/* Only jump if the other rank is still ahead of wherever this one got to in the meantime. */
+		if (this->Advance(false) && this->Global.Rank != this->PID
+			&& this->Global.Err > mpfr_get_d(LocalError.Err.mpfr_srcptr(), MPFR_RNDN))
+		{
+			EvalResults TheirError;
+			Configuration TheirConf;
+			impl::Deserializer Reader(this->Incoming);
+			if (Reader.Read(TheirError) && Reader.Read(TheirConf))
+			{
+				LocalError = TheirError;
+				LocalConf = TheirConf;
+				return true;
+			}
+		}
+		return Adopted;
 	}
 
-	bool ResourcesAvailable = true;
-	while (ResourcesAvailable)
+	void Finish(EvalResults &WorstError)
 	{
-		LocalError = EvalResults{};
-		PartNextConfs.clear();
+		this->Exec.Finish(WorstError);
 
-		for (uint64_t TID = 0; TID < NumThreads; TID++)
+		/* Every rank must take part in the same number of exchanges, so keep going (with nothing to offer) until all are done. */
+		if (this->Interval != 0)
 		{
-			while (Continue[TID] != EMPTY) { }
-			LocalErrors[TID] = EvalResults{};
-			LocalConfs[TID].clear();
+			this->Advance(true);
+			while (this->AnyActive)
+			{
+				this->Begin(EvalResults{}, Configuration{}, false);
+				this->Advance(true);
+			}
+			this->Generations = 0;
+			this->AnyActive = 1;
 		}
 
-		const std::vector<Configuration> NextConfs = BGRT.NextGen(Iterations);
-		
-		/* Use a lambda to apply filtering to the next configurations to apply.
-		 * In this case, prune any job which has the size less than the range
-		 * (ie, the delta between min and max interval < some range)
-		 */
-		uint64_t TotalJobs = 0;
-		PartNextConfs = dom::impl::PartitionConfigs<T>(NumThreads, NextConfs, [&TotalJobs, MinRange](const Configuration &Config){
-			bool Okay = true;
-			for (const auto &Pair : Config)
+		impl::ReduceWorst(WorstError, this->Comm);
+	}
+
+private:
+	enum class ExchangePhase
+	{
+		Idle,
+		Reducing,
+		Sizing,
+		Sending,
+	};
+
+	/* Laid out as MPI_DOUBLE_INT, for MPI_MAXLOC */
+	struct RankError
+	{
+		double Err;
+		int Rank;
+	};
+
+	/**
+	 * @brief Starts an exchange, offering a state to the other ranks.
+	 * @param Active Whether the search on this rank is still running
+	 */
+	void Begin(const EvalResults &LocalError, const Configuration &LocalConf, bool Active)
+	{
+		this->Offered = RankError{mpfr_get_d(LocalError.Err.mpfr_srcptr(), MPFR_RNDN), this->PID};
+		this->Packed.Clear();
+		this->Packed.Write(LocalError);
+		this->Packed.Write(LocalConf);
+		this->Active = Active ? 1 : 0;
+
+		MPI_Iallreduce(&this->Offered, &this->Global, 1, MPI_DOUBLE_INT, MPI_MAXLOC, this->Comm, &this->Requests[0]);
+		MPI_Iallreduce(&this->Active, &this->AnyActive, 1, MPI_INT, MPI_MAX, this->Comm, &this->Requests[1]);
+		this->NumRequests = 2;
+		this->Phase = ExchangePhase::Reducing;
+	}
+
+	/**
+	 * @brief Moves the exchange in progress along as far as it can go.
+	 * @param Block Whether to wait for every step, rather than stopping at the first one which isn't done yet
+	 * @return Whether the exchange finished with a configuration received into Incoming
+	 */
+	bool Advance(bool Block)
+	{
+		while (this->Phase != ExchangePhase::Idle)
+		{
+			int Done = 1;
+			if (Block)
+			{
+				MPI_Waitall(this->NumRequests, this->Requests, MPI_STATUSES_IGNORE);
+			}
+			else
+			{
+				MPI_Testall(this->NumRequests, this->Requests, &Done, MPI_STATUSES_IGNORE);
+			}
+			if (!Done)
 			{
-				if (Pair.second.Size() < MinRange)
+				return false;
+			}
+
+			switch (this->Phase)
+			{
+			case ExchangePhase::Reducing:
+				/* Nobody has anything worth sending. */
+				if (!(this->Global.Err > 0.0))
 				{
-					Okay = false;
+					this->Phase = ExchangePhase::Idle;
+					return false;
 				}
+				this->Size = this->Packed.Bytes().size();
+				MPI_Ibcast(&this->Size, 1, MPI_UINT64_T, this->Global.Rank, this->Comm, &this->Requests[0]);
+				this->NumRequests = 1;
+				this->Phase = ExchangePhase::Sizing;
+				break;
+
+			case ExchangePhase::Sizing:
+				this->Incoming = (this->Global.Rank == this->PID) ? this->Packed.Bytes() : std::vector<uint8_t>(this->Size);
+				MPI_Ibcast(this->Incoming.data(), (int)this->Size, MPI_BYTE, this->Global.Rank, this->Comm, &this->Requests[0]);
+				this->NumRequests = 1;
+				this->Phase = ExchangePhase::Sending;
+				break;
+
+			case ExchangePhase::Sending:
+				this->Phase = ExchangePhase::Idle;
+				return true;
+
+			case ExchangePhase::Idle:
+				break;
+			}
+		}
+		return false;
+	}
+
+	Inner &Exec;
+	MPI_Comm Comm;
+	uint64_t Interval;
+	int PID;
+
+	/* The exchange in progress, if any */
+	ExchangePhase Phase = ExchangePhase::Idle;
+	uint64_t Generations = 0;
+	MPI_Request Requests[2];
+	int NumRequests = 0;
+	RankError Offered;
+	RankError Global;
+	int Active = 1;
+	int AnyActive = 1;
+	uint64_t Size = 0;
+	impl::Serializer Packed;
+	std::vector<uint8_t> Incoming;
+};
+
+/**
+ * @brief Runs searches on an inner executor, letting idle MPI ranks take part of the configuration being searched by busy ones.
+ * @details Every generation, a rank which is searching answers any steal requests sent to it: it splits what is left of
+ * its search (the configuration it restarts from) along the widest variable, keeps the half it is currently searching in,
+ * and sends the other half (at full precision) to the rank which asked. From then on, it neither searches nor restarts
+ * into the half it gave away, so no part of the box is searched twice. It gives nothing if either half would be filtered
+ * out, so that the thief doesn't immediately run out of work and ask again.
+ * A rank with nothing left to search calls Steal() to ask every other rank in turn, and Retire() once nobody had anything to
+ * give. Requests are only ever answered, never waited on, by a rank which is busy; idle ranks keep answering (with nothing)
+ * while they wait for work or for every rank to retire, so no rank can block another. Every answer is sent without
+ * blocking, and the thief polls for it instead of probing.
+ *
+ * Unlike MPIExecutor, results are not combined at the end of every search, since a rank may run any number of them.
+ */
+template<typename T, typename Inner>
+class MPIStealingExecutor
+{
+public:
+	using Configuration = std::unordered_map<uint64_t, bgrt::Variable<T>>;
+
+	/**
+	 * @param Exec The executor to use within this rank. It must outlive this executor.
+	 * @param Comm The communicator containing every rank taking part in the search
+	 */
+	MPIStealingExecutor(Inner &Exec, MPI_Comm Comm = MPI_COMM_WORLD) : Exec(Exec), Comm(Comm)
+	{
+		MPI_Comm_rank(this->Comm, &this->PID);
+		MPI_Comm_size(this->Comm, &this->NumP);
+	}
+
+	uint64_t Workers() const
+	{
+		return this->Exec.Workers();
+	}
+
+	template<typename ProduceFn>
+	void Generate(std::vector<std::vector<Configuration>> &Parts, ProduceFn &Produce)
+	{
+		this->Exec.Generate(Parts, Produce);
+	}
+
+	template<typename Job>
+	void Execute(const std::vector<std::vector<Configuration>> &Parts, std::vector<impl::WorkerResult<T>> &Results, Job &Evaluate)
+	{
+		this->Exec.Execute(Parts, Results, Evaluate);
+	}
+
+	template<typename FilterFn>
+	bool Share(EvalResults &LocalError, Configuration &LocalConf, Configuration &Base, const FilterFn &Accept)
+	{
+		bool Adopted = this->Exec.Share(LocalError, LocalConf, Base, Accept);
+		return this->Serve(&LocalConf, &Base, Accept) || Adopted;
+	}
+
+	void Finish(EvalResults &WorstError)
+	{
+		this->Exec.Finish(WorstError);
+	}
 
-				TotalJobs += (1 * Okay);
+	/**
+	 * @brief Asks every other rank in turn for part of what it is searching, until one of them has something to give.
+	 * @param Out Where to put the configuration which was given
+	 * @return Whether any rank gave anything
+	 */
+	bool Steal(Configuration &Out)
+	{
+		for (int Offset = 1; Offset < this->NumP; Offset++)
+		{
+			/* Start somewhere different every time, so that thieves spread out over their victims. */
+			const int Victim = (this->PID + this->Round + Offset) % this->NumP;
+			if (Victim == this->PID)
+			{
+				continue;
 			}
-			return Okay;
-		});		
 
-		/* We're done if every possible job was too close to the boundary. */
-		if (TotalJobs == 0)
+			MPI_Request Asked;
+			MPI_Isend(nullptr, 0, MPI_BYTE, Victim, StealTag, this->Comm, &Asked);
+
+			/* The answer is the size of the work, and then the work itself if there is any. Keep answering everyone else
+			 * while waiting for either, in case they're trying to steal from this rank too.
+			 */
+			uint64_t Size = 0;
+			MPI_Request Answer;
+			MPI_Irecv(&Size, 1, MPI_UINT64_T, Victim, SizeTag, this->Comm, &Answer);
+			this->Await(Answer);
+
+			std::vector<uint8_t> Bytes(Size);
+			if (Size != 0)
+			{
+				MPI_Irecv(Bytes.data(), (int)Size, MPI_BYTE, Victim, WorkTag, this->Comm, &Answer);
+				this->Await(Answer);
+			}
+			MPI_Wait(&Asked, MPI_STATUS_IGNORE);
+
+			impl::Deserializer Reader(Bytes);
+			if (Size != 0 && Reader.Read(Out))
+			{
+				this->Round++;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Waits for every rank to run out of work, answering any steal requests (with nothing) in the meantime.
+	 * @details Every rank must call this once, after Steal() has failed or the search was cancelled.
+	 */
+	void Retire()
+	{
+		MPI_Request Request;
+		MPI_Ibarrier(this->Comm, &Request);
+
+		int Done = 0;
+		while (!Done)
 		{
-			ResourcesAvailable = false;
-			break;
+			this->Serve(nullptr);
+			MPI_Test(&Request, &Done, MPI_STATUS_IGNORE);
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
 		}
 
-		/* Issue work to the worker threads */
-		for (uint64_t TID = 0; TID < NumThreads; TID++)
+		/* Every thief has taken its answer by now, since none of them can retire before getting one. */
+		for (Reply &Sent : this->Replies)
 		{
-			while (Continue[TID] != EMPTY) { }
-			Continue[TID] = WORK_AVAIL;
+			MPI_Waitall(2, Sent.Requests, MPI_STATUSES_IGNORE);
 		}
+		this->Replies.clear();
+	}
 
+private:
+	static constexpr int StealTag = 1;
+	static constexpr int SizeTag = 2;
+	static constexpr int WorkTag = 3;
 
-		/* Collect results on all the worker threads sequentially.
-		 * In theory, this can be redone with condition variables
-		 * to allow any thread to complete in any order, but since
-		 * this isn't a distributed systems problem (and we're assuming SMP)
-		 * every core should eventually offer a reply, and roughly at the
-		 * same time anyway. If this was not true, then the machine running
-		 * this code must have crashed (or ran out of resources), such that
-		 * there's no real way to continue anyway.
-		 */
-		for (uint64_t TID = 0; TID < NumThreads; TID++)
+	/**
+	 * @brief An answer to a steal request, which must be kept until it has been sent.
+	 */
+	typedef struct Reply
+	{
+		uint64_t Size;
+		std::vector<uint8_t> Bytes;
+		MPI_Request Requests[2];
+	}Reply;
+
+	/**
+	 * @brief Waits for a receive to complete, answering steal requests in the meantime.
+	 */
+	void Await(MPI_Request &Request)
+	{
+		int Done = 0;
+		MPI_Test(&Request, &Done, MPI_STATUS_IGNORE);
+		while (!Done)
 		{
-			while (Continue[TID] != EMPTY) { }
-			if (LocalErrors[TID].Err > LocalError.Err)
+			this->Serve(nullptr);
+			std::this_thread::yield();
+			MPI_Test(&Request, &Done, MPI_STATUS_IGNORE);
+		}
+	}
+
+	/**
+	 * @brief Answers every steal request which has arrived, and forgets every answer which has been sent.
+	 * @param Conf The configuration being searched, half of which is given away to the first request. nullptr if idle.
+	 * @param Base The configuration the search restarts from, which is split with Conf (see impl::Halve). nullptr if idle.
+	 * @param Accept The filtering policy of the search
+	 * @return Whether Conf was split
+	 */
+	template<typename FilterFn = AcceptAll>
+	bool Serve(Configuration *Conf, Configuration *Base = nullptr, const FilterFn &Accept = FilterFn{})
+	{
+		bool Split = false;
+
+		std::erase_if(this->Replies, [](Reply &Sent)
+		{
+			int Done = 0;
+			MPI_Testall(2, Sent.Requests, &Done, MPI_STATUSES_IGNORE);
+			return Done != 0;
+		});
+
+		MPI_Status Status;
+		int Pending = 0;
+		MPI_Iprobe(MPI_ANY_SOURCE, StealTag, this->Comm, &Pending, &Status);
+		while (Pending)
+		{
+			MPI_Recv(nullptr, 0, MPI_BYTE, Status.MPI_SOURCE, StealTag, this->Comm, MPI_STATUS_IGNORE);
+
+			this->Writer.Clear();
+			if (Conf != nullptr && !Split)
+			{
+				Configuration Given;
+				if (impl::Halve(*Conf, *Base, Accept, Given))
+				{
+					this->Writer.Write(Given);
+					Split = true;
+				}
+			}
+
+			/* The answer is sent without waiting, so it has to stay around until it has gone. */
+			Reply &Sent = this->Replies.emplace_back(Reply{this->Writer.Bytes().size(), this->Writer.Bytes(),
+				{MPI_REQUEST_NULL, MPI_REQUEST_NULL}});
+			MPI_Isend(&Sent.Size, 1, MPI_UINT64_T, Status.MPI_SOURCE, SizeTag, this->Comm, &Sent.Requests[0]);
+			if (Sent.Size != 0)
 			{
-				LocalError = LocalErrors[TID];
-				LocalConf = LocalConfs[TID];
-				BGRT.SetVals(LocalConf);
+				MPI_Isend(Sent.Bytes.data(), (int)Sent.Size, MPI_BYTE, Status.MPI_SOURCE, WorkTag, this->Comm, &Sent.Requests[1]);
 			}
+
+			MPI_Iprobe(MPI_ANY_SOURCE, StealTag, this->Comm, &Pending, &Status);
 		}
+		return Split;
+	}
+
+	Inner &Exec;
+	MPI_Comm Comm;
+	int PID;
+	int NumP;
+	uint64_t Round = 0;
+	impl::Serializer Writer;
+
+	/* Answers which may not have been sent yet, each of which must stay where it is until then. */
+	std::list<Reply> Replies;
+};
+
+/**
+ * @brief Implements a multi-threaded variant of the BGRT algorithm to efficiently find floating point errors
+ * @author Brian Schnepp
+ * @see https://formalverification.cs.utah.edu/grt/publications/ppopp14-s3fp.pdf
+ * @param InitConf The initial BGRT variable configuration
+ * @param Iterations The number of configurations to create upon every previous configuration given
+ * @param Resources The number of bits which need to be ignored in the mantissa of range: numbers differing by less than this range are ignored.
+ * @param RestartPercent The percentage, as a whole integer, where the initial configuration is reset to avoid local minima
+ * @param F The function which takes a BGRT configuration to check for floating-point error with.
+ * @param k The number of times to execute F, looking for potential error
+ * @param LogFreq Chance (out of 10000) that a log is printed after any given generation. Default is 5000.
+ * @param LogOut A stream to send messages to for logging. Default is std::cout.
+ * @param Options How to run the search on each rank, and what else to report. See SearchOptions.
+ * @return The highest error of the function that was ever found, described as "WorstError" in the paper
+ */
+template<typename T>
+EvalResults FindErrorMantissaMPI(const std::unordered_map<uint64_t, bgrt::Variable<T>> &InitConf,
+		std::unordered_map<uint64_t, dom::Value<T>> (*F)(std::unordered_map<uint64_t, dom::Value<T>>&),
+		const uint64_t Iterations = 100, const int64_t Resources = 0, const uint64_t RestartPercent = 5,
+		uint64_t k = 1000, uint64_t LogFreq = 5000, std::ostream &LogOut = std::cout, const SearchOptions &Options = {})
+{
+	dom::hpfloat hLim = (dom::hpfloat)std::numeric_limits<T>::epsilon();
+	/* Provide one extra Resource to account for rounding */
+	dom::hpfloat mLim = hLim * dom::hp::pow(2.0, (Resources-1));
+
+	int NumP;
+	MPI_Comm_size(MPI_COMM_WORLD, &NumP);
+	
+	int PID;
+	MPI_Comm_rank(MPI_COMM_WORLD, &PID);
+
+	uint64_t MyK = k / NumP;
+	if (PID + 1 == NumP) {
+		MyK += k % NumP;
+	}
+
+	dom::ThreadExecutor<T> Inner(Options.NumThreads, Options.PinThreads);
+	dom::MPIExecutor<T, dom::ThreadExecutor<T>> Exec(Inner);
+	dom::SearchEngine<T, dom::FilterExhausted, dom::MinRangeFilter, dom::RandomRestart, dom::MPIExecutor<T, dom::ThreadExecutor<T>>> Engine(F, Exec,
+		dom::FilterExhausted{}, dom::MinRangeFilter{mLim}, dom::RandomRestart{RestartPercent}, Iterations, MyK, LogFreq, LogOut);
+	return Engine.Run(impl::AgreeOnInputs(InitConf, F, Options.ProbeSamples, MPI_COMM_WORLD), impl::Probed(Options));
+}
+
+/**
+ * @brief Implements an MPI variant of the BGRT algorithm to efficiently find floating point errors
+ * @author Brian Schnepp
+ * @see https://formalverification.cs.utah.edu/grt/publications/ppopp14-s3fp.pdf
+ * @param InitConf The initial BGRT variable configuration
+ * @param Iterations The number of configurations to create upon every previous configuration given
+ * @param Resources The rough limit on the number of floating point computations to perform. Actual executions may exceed this value by a fair amount.
+ * @param RestartPercent The percentage, as a whole integer, where the initial configuration is reset to avoid local minima
+ * @param F The function which takes a BGRT configuration to check for floating-point error with.
+ * @param k The number of times to execute F, looking for potential error
+ * @param LogFreq Chance (out of 10000) that a log is printed after any given generation. Default is 4000.
+ * @param LogOut A stream to send messages to for logging. Default is std::cout.
+ * @param Options How to run the search on each rank, and what else to report. See SearchOptions.
+ * @return The highest error of the function that was ever found, described as "WorstError" in the paper
+ */
+template<typename T>
+EvalResults FindErrorBoundConfMPI(const std::unordered_map<uint64_t, bgrt::Variable<T>> &InitConf,
+		std::unordered_map<uint64_t, dom::Value<T>> (*F)(std::unordered_map<uint64_t, dom::Value<T>>&),
+		const uint64_t Iterations = 1000, const dom::hpfloat MinRange = std::numeric_limits<T>::epsilon(), 
+		const uint64_t RestartPercent = 5, uint64_t k = 25, uint64_t LogFreq = 4000, std::ostream &LogOut = std::cout,
+		const SearchOptions &Options = {})
+{
+	dom::ThreadExecutor<T> Inner(Options.NumThreads, Options.PinThreads);
+	dom::MPIExecutor<T, dom::ThreadExecutor<T>> Exec(Inner);
+	dom::SearchEngine<T, dom::FilterExhausted, dom::MinRangeFilter, dom::RandomRestart, dom::MPIExecutor<T, dom::ThreadExecutor<T>>> Engine(F, Exec,
+		dom::FilterExhausted{}, dom::MinRangeFilter{MinRange}, dom::RandomRestart{RestartPercent}, Iterations, k, LogFreq, LogOut);
+	return Engine.Run(impl::AgreeOnInputs(InitConf, F, Options.ProbeSamples, MPI_COMM_WORLD), impl::Probed(Options));
+}
+
+/**
+ * @brief Implements an MPI variant of the BGRT algorithm which splits the initial configuration between ranks, rather than
+ * having every rank search all of it.
+ * @details The initial configuration is split into disjoint sub-boxes by recursive bisection along the widest variables, several
+ * per rank. Ranks then take boxes one at a time from a shared counter on rank 0 (through MPI_Fetch_and_op), and search each
+ * one with a multi-threaded search until its range filter is exhausted. Ranks which finish early simply take more boxes, so the
+ * work is rebalanced toward whichever boxes take longest, and N ranks cover N times the volume of one. Once every box has
+ * been taken, idle ranks steal half of what busy ranks have left to search (see MPIStealingExecutor), until nothing is left.
+ * @author Brian Schnepp
+ * @see https://formalverification.cs.utah.edu/grt/publications/ppopp14-s3fp.pdf
+ * @param InitConf The initial BGRT variable configuration
+ * @param Iterations The number of configurations to create upon every previous configuration given
+ * @param Resources The number of bits which need to be ignored in the mantissa of range: numbers differing by less than this range are ignored.
+ * @param RestartPercent The percentage, as a whole integer, where the initial configuration (of each box) is reset to avoid local minima
+ * @param F The function which takes a BGRT configuration to check for floating-point error with.
+ * @param k The number of times to execute F, looking for potential error
+ * @param LogFreq Chance (out of 10000) that a log is printed after any given generation. Default is 5000.
+ * @param LogOut A stream to send messages to for logging. Default is std::cout.
+ * @param Options How to run the search on each rank, and what else to report, including how many boxes to split the
+ * initial configuration into. See SearchOptions. The profile is summed over every search of the rank, and the progress
+ * starts over with each one.
+ * @return The highest error of the function that was ever found by any rank, described as "WorstError" in the paper
+ */
+template<typename T>
+EvalResults FindErrorDecomposedMPI(const std::unordered_map<uint64_t, bgrt::Variable<T>> &InitConf,
+		std::unordered_map<uint64_t, dom::Value<T>> (*F)(std::unordered_map<uint64_t, dom::Value<T>>&),
+		const uint64_t Iterations = 100, const int64_t Resources = 0, const uint64_t RestartPercent = 5,
+		uint64_t k = 1000, uint64_t LogFreq = 5000, std::ostream &LogOut = std::cout, const SearchOptions &Options = {})
+{
+	dom::hpfloat hLim = (dom::hpfloat)std::numeric_limits<T>::epsilon();
+	/* Provide one extra Resource to account for rounding */
+	dom::hpfloat mLim = hLim * dom::hp::pow(2.0, (Resources-1));
+
+	int NumP;
+	MPI_Comm_size(MPI_COMM_WORLD, &NumP);
+
+	int PID;
+	MPI_Comm_rank(MPI_COMM_WORLD, &PID);
+
+	/* Every rank splits rank 0's configuration the same way, so only the index of each box needs to be handed out. Unused inputs aren't worth splitting. */
+	const std::unordered_map<uint64_t, bgrt::Variable<T>> Live = impl::AgreeOnInputs(InitConf, F, Options.ProbeSamples, MPI_COMM_WORLD);
+	const std::vector<std::unordered_map<uint64_t, bgrt::Variable<T>>> Boxes = impl::Decompose(Live, NumP * Options.BoxesPerRank);
 
-		/* Is the error in this configuration higher than the global maximum? */
-		if (LocalError.Err > WorstError.Err)
+	/* The index of the next box nobody has taken yet lives on rank 0. */
+	int64_t NextBox = 0;
+	MPI_Win Window;
+	MPI_Win_create(&NextBox, (PID == 0) ? sizeof(NextBox) : 0, sizeof(NextBox), MPI_INFO_NULL, MPI_COMM_WORLD, &Window);
+
+	dom::ThreadExecutor<T> Inner(Options.NumThreads, Options.PinThreads);
+	dom::MPIStealingExecutor<T, dom::ThreadExecutor<T>> Exec(Inner);
+	dom::SearchEngine<T, dom::FilterExhausted, dom::MinRangeFilter, dom::RandomRestart, dom::MPIStealingExecutor<T, dom::ThreadExecutor<T>>> Engine(F, Exec,
+		dom::FilterExhausted{}, dom::MinRangeFilter{mLim}, dom::RandomRestart{RestartPercent}, Iterations, k, LogFreq, LogOut);
+
+	/* Every box is a search of its own, so the profile of each is added up here instead. */
+	SearchOptions Each = impl::Probed(Options);
+	Each.Profile = nullptr;
+	SearchProfile Total{};
+	const CancellationToken *Token = Options.Token;
+
+	EvalResults WorstError = EvalResults{};
+	while (Token == nullptr || !Token->Expired())
+	{
+		const int64_t One = 1;
+		int64_t Box = 0;
+		MPI_Win_lock(MPI_LOCK_SHARED, 0, 0, Window);
+		MPI_Fetch_and_op(&One, &Box, MPI_INT64_T, 0, 0, MPI_SUM, Window);
+		MPI_Win_unlock(0, Window);
+		if (Box >= (int64_t)Boxes.size())
 		{
-			WorstError = LocalError;
+			break;
 		}
 
-		if ((Dist(Gen) * Dist(Gen)) <= LogFreq)
+		EvalResults Res = Engine.Run(Boxes[Box], Each);
+		impl::Accumulate(Total, Engine.Profile());
+		if (Res.Err > WorstError.Err)
 		{
-			LogOut << "(CurError " << "(abs " << WorstError.Err << ")" << ", (rel " << WorstError.RelErr << "))" << std::endl;
+			WorstError = Res;
 		}
+	}
 
-		/* Sometimes re-issue the original configuration, to avoid getting stuck. */
-		RandomRestart = (Dist(Gen) % 100) < RestartPercent;
-		if (RandomRestart)
+	/* Every box has been handed out, so help whichever ranks are still busy, until none of them have anything left to give. */
+	std::unordered_map<uint64_t, bgrt::Variable<T>> Stolen;
+	while ((Token == nullptr || !Token->Expired()) && Exec.Steal(Stolen))
+	{
+		EvalResults Res = Engine.Run(Stolen, Each);
+		impl::Accumulate(Total, Engine.Profile());
+		if (Res.Err > WorstError.Err)
 		{
-			LocalConf = InitConf;
-			BGRT.SetVals(LocalConf);
+			WorstError = Res;
 		}
 	}
-	for (uint64_t TID = 0; TID < NumThreads; TID++)
+	Exec.Retire();
+
+	if (Options.Profile != nullptr)
 	{
-		Continue[TID] = TERMINATE;
-		Threads[TID].join();
+		*Options.Profile = Total;
 	}
 
+	MPI_Win_free(&Window);
+	impl::ReduceWorst(WorstError, MPI_COMM_WORLD);
 	return WorstError;
 }
 
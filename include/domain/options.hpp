@@ -0,0 +1,60 @@
+#include <cstdint>
+
+#include "domain/control.hpp"
+#include "domain/profile.hpp"
+#include "domain/distribution.hpp"
+
+#ifndef DOMAIN_OPTIONS_HPP_
+#define DOMAIN_OPTIONS_HPP_
+
+/**
+ * @file include/domain/options.hpp
+ * @brief The options every FindError driver takes, beyond what defines the search itself
+ */
+
+namespace dom
+{
+
+/**
+ * @brief How a driver should run its search, and what it should report besides the worst error.
+ * @details Every driver takes one of these as its last parameter, so new options are added here rather than to every
+ * signature. Options a driver has no use for are ignored: the serial drivers have no workers to count or pin, for example.
+ * Anything pointed to must outlive the search.
+ * @author Brian Schnepp
+ */
+typedef struct SearchOptions
+{
+	/* The number of workers to evaluate with (per rank, for the MPI drivers). 0 (default) gets one per hardware thread. */
+	uint64_t NumThreads = 0;
+
+	/* Whether each worker thread should be pinned to its own CPU, keeping its configurations on the local NUMA node. */
+	bool PinThreads = false;
+
+	/* A token which can stop the search early, by cancellation or a deadline. nullptr (default) runs until done. */
+	const CancellationToken *Token = nullptr;
+
+	/* If not nullptr, the distribution of every error seen (by this rank) is added to it. */
+	ErrorStatistics *Distribution = nullptr;
+
+	/* How many times to run F beforehand (on rank 0, for the MPI drivers), looking for inputs which never affect an output,
+	 * which are then left out of the search. 0 (default) keeps every input.
+	 */
+	uint64_t ProbeSamples = 0;
+
+	/* If not nullptr, set to where the search spent its time and allocations. This is all 0 unless libdomain is built
+	 * with DOMAIN_PROFILE.
+	 */
+	SearchProfile *Profile = nullptr;
+
+	/* If not nullptr, the progress of the search is published to it after every generation. */
+	SearchProgress *Progress = nullptr;
+
+	/* For FindErrorDecomposedMPI, how many sub-boxes to split the initial configuration into, for every rank. More boxes
+	 * balance better, but each one is smaller.
+	 */
+	uint64_t BoxesPerRank = 4;
+}SearchOptions;
+
+}
+
+#endif
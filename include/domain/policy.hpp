@@ -0,0 +1,382 @@
+#include <cmath>
+#include <tuple>
+#include <vector>
+#include <limits>
+#include <random>
+#include <cstdint>
+#include <unordered_map>
+
+#include <value.hpp>
+#include <hpfloat.hpp>
+#include <bgrt/bgrt.hpp>
+
+#include "domain/sensitivity.hpp"
+
+#ifndef DOMAIN_POLICY_HPP_
+#define DOMAIN_POLICY_HPP_
+
+/**
+ * @file include/domain/policy.hpp
+ * @brief Stopping, filtering, restart, and splitting policies for the SearchEngine
+ */
+
+namespace dom
+{
+
+/**
+ * @brief The progress of a search, as seen by a stopping policy
+ * @author Brian Schnepp
+ */
+typedef struct SearchState
+{
+	/* Number of generations which have been fully evaluated */
+	uint64_t Generation;
+
+	/* Number of configurations produced for the most recent generation, before and after filtering */
+	uint64_t Generated;
+	uint64_t Accepted;
+
+	/* Running totals over the whole search */
+	uint64_t ShadowOps;
+	uint64_t Evaluated;
+	uint64_t Samples;
+}SearchState;
+
+/**
+ * @brief Stops once some number of shadow value computations have been performed.
+ * @details Workers check the budget before every batch of configurations, so it may be exceeded by up to one batch per worker.
+ */
+struct ShadowOpBudget
+{
+	int64_t Resources;
+
+	bool Done(const SearchState &State) const
+	{
+		return (int64_t)State.ShadowOps > this->Resources;
+	}
+};
+
+/**
+ * @brief Stops once every configuration in a generation was rejected by the filter.
+ * @details This is the termination condition of the range-bounded searches: eventually every child is too narrow to be worth evaluating.
+ */
+struct FilterExhausted
+{
+	bool Done(const SearchState &State) const
+	{
+		return State.Generated != 0 && State.Accepted == 0;
+	}
+};
+
+/**
+ * @brief Stops as soon as any of a set of stopping policies would.
+ */
+template<typename... Stops>
+struct AnyOf
+{
+	AnyOf(Stops... Policies) : Policies(Policies...) {}
+
+	bool Done(const SearchState &State) const
+	{
+		return std::apply([&State](const auto&... P) { return (P.Done(State) || ...); }, this->Policies);
+	}
+
+	std::tuple<Stops...> Policies;
+};
+
+/**
+ * @brief Accepts every configuration.
+ */
+struct AcceptAll
+{
+	template<typename T>
+	bool operator()(const std::unordered_map<uint64_t, bgrt::Variable<T>> &/* Config */) const
+	{
+		return true;
+	}
+};
+
+/**
+ * @brief Rejects any configuration where some variable has a range narrower than a fixed bound.
+ */
+struct MinRangeFilter
+{
+	dom::hpfloat MinRange;
+
+	template<typename T>
+	bool operator()(const std::unordered_map<uint64_t, bgrt::Variable<T>> &Config) const
+	{
+		for (const auto &Pair : Config)
+		{
+			if (Pair.second.Size().SVal() < this->MinRange)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+/**
+ * @brief Rejects any configuration where some variable's range is smaller than a given number of ULPs at its lower bound.
+ * @details The threshold for a variable with bounds [Min, Max] is |Scale * Min * 0.5 * epsilon * (Resources + 1)|,
+ * such that numbers differing by less than that are not worth separating.
+ */
+template<typename T>
+struct MantissaRangeFilter
+{
+	/**
+	 * @param Resources The number of bits which need to be ignored in the mantissa of range
+	 * @param Scale The scaling to apply to the epsilon calculation
+	 */
+	MantissaRangeFilter(int64_t Resources = 0, T Scale = 1.0)
+	{
+		dom::hpfloat Lim = (dom::hpfloat)std::numeric_limits<T>::epsilon();
+		this->Eps = Scale * (0.5 * Lim * (Resources + 1));
+	}
+
+	bool operator()(const std::unordered_map<uint64_t, bgrt::Variable<T>> &Config) const
+	{
+		for (const auto &Pair : Config)
+		{
+			dom::hpfloat RangeSize = Pair.second.Size().SVal();
+
+			dom::hpfloat Min = Pair.second.Min().SVal();
+			dom::hpfloat Max = Pair.second.Max().SVal();
+			dom::hpfloat Bigger = (Min < Max) ? Min : Max;
+
+			dom::hpfloat Filter = Bigger * this->Eps;
+			Filter = (Filter < 0) ? -Filter : Filter;
+
+			if (RangeSize < Filter)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	dom::hpfloat Eps;
+};
+
+/**
+ * @brief Accepts a configuration only if every one of a set of filters does.
+ */
+template<typename... Filters>
+struct AllOf
+{
+	AllOf(Filters... Policies) : Policies(Policies...) {}
+
+	template<typename Configuration>
+	bool operator()(const Configuration &Config) const
+	{
+		return std::apply([&Config](const auto&... P) { return (P(Config) && ...); }, this->Policies);
+	}
+
+	std::tuple<Filters...> Policies;
+};
+
+/**
+ * @brief Never returns to the initial configuration.
+ */
+struct NoRestart
+{
+	template<typename Generator>
+	bool operator()(Generator &Gen) const
+	{
+		return false;
+	}
+};
+
+/**
+ * @brief Returns to the initial configuration after a generation with some fixed chance, to avoid getting stuck in local minima.
+ */
+struct RandomRestart
+{
+	/* The percentage, as a whole integer, where the initial configuration is reset */
+	uint64_t Percent;
+
+	template<typename Generator>
+	bool operator()(Generator &Gen) const
+	{
+		std::uniform_int_distribution<int> Dist(0, 100);
+		return (uint64_t)(Dist(Gen) % 100) < this->Percent;
+	}
+};
+
+/**
+ * @brief One configuration evaluated in a generation, as seen by a splitting policy.
+ */
+template<typename T>
+struct SplitOutcome
+{
+	const std::unordered_map<uint64_t, bgrt::Variable<T>> *Conf;
+	double Err;
+};
+
+/**
+ * @brief Splits variables into groups uniformly at random, as in the S3FP paper.
+ */
+struct UniformSplit
+{
+	template<typename Function, typename T>
+	void Begin(Function /* F */, bgrt::BGRTState<T> &/* State */,
+		const std::unordered_map<uint64_t, bgrt::Variable<T>> &/* InitConf */)
+	{
+	}
+
+	template<typename T>
+	void Update(bgrt::BGRTState<T> &/* State */, const std::unordered_map<uint64_t, bgrt::Variable<T>> &/* Parent */,
+		const std::vector<SplitOutcome<T>> &/* Children */)
+	{
+	}
+};
+
+/**
+ * @brief Biases the split once, before the search starts, by the derivatives of F over the initial configuration.
+ * @see dom::Sensitivity
+ */
+struct SensitivitySplit
+{
+	/* How many points to sample F at */
+	uint64_t Samples = 16;
+
+	template<typename Function, typename T>
+	void Begin(Function F, bgrt::BGRTState<T> &State, const std::unordered_map<uint64_t, bgrt::Variable<T>> &InitConf)
+	{
+		State.SetBias(dom::Sensitivity(F, InitConf, this->Samples).Bias());
+	}
+
+	template<typename T>
+	void Update(bgrt::BGRTState<T> &/* State */, const std::unordered_map<uint64_t, bgrt::Variable<T>> &/* Parent */,
+		const std::vector<SplitOutcome<T>> &/* Children */)
+	{
+	}
+};
+
+/**
+ * @brief Biases the split toward moving variables in the directions which went along with higher error in past generations.
+ * @details Every child of a generation moves each variable up (into the upper half of its parent's range) or down. After the
+ * generation, each variable's direction is correlated with the error of the children, compared by logarithm to the rest of
+ * the generation. A variable's credit is a running average of that correlation: positive if moving it up has tended to raise
+ * the error, and negative if moving it down has.
+ *
+ * Variables with credit of the same sign lean toward sharing a group, so that one of the two children of every split moves
+ * all of them in the direction that helped, in proportion to how strong their credit is next to the strongest one.
+ * Variables which have shown no pattern keep close to even odds.
+ */
+struct CreditSplit
+{
+	/**
+	 * @param Decay How much of a variable's credit is kept after every generation, between 0 and 1
+	 * @param Strength How far the bias may lean away from even odds, between 0 and 1
+	 */
+	CreditSplit(double Decay = 0.75, double Strength = 0.8) : Decay(Decay), Strength(Strength)
+	{
+	}
+
+	template<typename Function, typename T>
+	void Begin(Function /* F */, bgrt::BGRTState<T> &/* State */,
+		const std::unordered_map<uint64_t, bgrt::Variable<T>> &/* InitConf */)
+	{
+		this->Credit.clear();
+	}
+
+	template<typename T>
+	void Update(bgrt::BGRTState<T> &State, const std::unordered_map<uint64_t, bgrt::Variable<T>> &Parent,
+		const std::vector<SplitOutcome<T>> &Children)
+	{
+		const uint64_t Count = Children.size();
+		if (Count < 2)
+		{
+			return;
+		}
+
+		/* Errors span many orders of magnitude, so they are compared by their logarithm, as standard scores within the generation. */
+		std::vector<double> Scores(Count);
+		double Mean = 0.0;
+		for (uint64_t Index = 0; Index < Count; Index++)
+		{
+			double Err = (Children[Index].Err > 0.0) ? Children[Index].Err : std::numeric_limits<double>::min();
+			Scores[Index] = std::log2(Err);
+			Mean += Scores[Index] / Count;
+		}
+
+		double Variance = 0.0;
+		for (double Score : Scores)
+		{
+			Variance += ((Score - Mean) * (Score - Mean)) / Count;
+		}
+		if (!(Variance > 0.0) || !std::isfinite(Variance))
+		{
+			return;
+		}
+		const double Deviation = std::sqrt(Variance);
+
+		std::unordered_map<uint64_t, double> Correlation;
+		for (uint64_t Index = 0; Index < Count; Index++)
+		{
+			const double Score = (Scores[Index] - Mean) / Deviation;
+			for (const auto &Pair : *Children[Index].Conf)
+			{
+				auto Prev = Parent.find(Pair.first);
+				if (Prev == Parent.end())
+				{
+					continue;
+				}
+
+				if (Pair.second.Min().SVal() > Prev->second.Min().SVal())
+				{
+					Correlation[Pair.first] += Score / Count;
+				}
+				else if (Pair.second.Max().SVal() < Prev->second.Max().SVal())
+				{
+					Correlation[Pair.first] -= Score / Count;
+				}
+			}
+		}
+
+		for (const auto &Pair : Correlation)
+		{
+			double &Cred = this->Credit[Pair.first];
+			Cred = (this->Decay * Cred) + ((1.0 - this->Decay) * Pair.second);
+		}
+
+		/* Credits which were not updated this generation still get a bias, so they count toward the largest too. */
+		double Largest = 0.0;
+		for (const auto &Pair : this->Credit)
+		{
+			Largest = (std::fabs(Pair.second) > Largest) ? std::fabs(Pair.second) : Largest;
+		}
+		if (Largest == 0.0)
+		{
+			return;
+		}
+
+		std::unordered_map<uint64_t, double> Bias;
+		for (const auto &Pair : this->Credit)
+		{
+			double Lean = 0.5 + (0.5 * this->Strength * (Pair.second / Largest));
+			Bias[Pair.first] = (Lean < 0.0) ? 0.0 : ((Lean > 1.0) ? 1.0 : Lean);
+		}
+		State.SetBias(Bias);
+	}
+
+	/**
+	 * @brief The running credit of each variable, by key. Positive credit means moving it up tended to raise the error.
+	 */
+	const std::unordered_map<uint64_t, double> &Credits() const
+	{
+		return this->Credit;
+	}
+
+	double Decay;
+	double Strength;
+
+private:
+	std::unordered_map<uint64_t, double> Credit;
+};
+
+}
+
+#endif
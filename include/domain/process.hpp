@@ -0,0 +1,810 @@
+#include <new>
+#include <span>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/types.h>
+
+#include <value.hpp>
+#include <hpfloat.hpp>
+#include <bgrt/bgrt.hpp>
+
+#include "impl/serialize.hpp"
+
+#include "domain/util.hpp"
+#include "domain/policy.hpp"
+#include "domain/engine.hpp"
+#include "domain/options.hpp"
+#include "domain/distribution.hpp"
+#include "domain/executor.hpp"
+
+#ifndef DOMAIN_PROCESS_HPP_
+#define DOMAIN_PROCESS_HPP_
+
+/**
+ * @file include/domain/process.hpp
+ * @brief An executor which evaluates each slice of a generation in its own process, for a single node without MPI
+ */
+
+namespace dom
+{
+
+namespace impl
+{
+
+/**
+ * @brief The shared state of one ring: how many bytes have ever been written to it, and how many have been read.
+ * @details Both only ever grow, so the ring is empty when they are equal. Each is written by only one side.
+ */
+typedef struct RingHeader
+{
+	alignas(64) std::atomic<uint64_t> Head;
+	alignas(64) std::atomic<uint64_t> Tail;
+}RingHeader;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Rings in shared memory need lock-free atomics");
+
+/**
+ * @brief A queue of variable-length records in shared memory, written by one process and read by another.
+ * @details Each record is its length followed by its bytes, wrapping around the end of the buffer as needed.
+ * The ring itself doesn't own any memory: it is a view of a header and buffer which both processes have mapped.
+ * @author Brian Schnepp
+ */
+class SharedRing
+{
+public:
+	SharedRing(RingHeader *Header, uint8_t *Data, uint64_t Capacity) : Header(Header), Data(Data), Capacity(Capacity)
+	{
+	}
+
+	/**
+	 * @brief Empties the ring. This must not run while either side is using it.
+	 */
+	void Reset()
+	{
+		this->Header->Head.store(0, std::memory_order_relaxed);
+		this->Header->Tail.store(0, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Whether a record of some size could ever be written to the ring.
+	 */
+	bool Fits(const std::vector<uint8_t> &Record) const
+	{
+		return sizeof(uint64_t) + Record.size() <= this->Capacity;
+	}
+
+	/**
+	 * @brief Appends a record if there is room for it right now.
+	 * @param Record The bytes to write, which must fit in the ring
+	 * @return Whether the record was written
+	 */
+	bool TryPush(const std::vector<uint8_t> &Record)
+	{
+		const uint64_t Size = Record.size();
+		const uint64_t Needed = sizeof(Size) + Size;
+		const uint64_t Head = this->Header->Head.load(std::memory_order_relaxed);
+		if (this->Capacity - (Head - this->Header->Tail.load(std::memory_order_acquire)) < Needed)
+		{
+			return false;
+		}
+
+		this->Copy(Head, &Size, sizeof(Size));
+		this->Copy(Head + sizeof(Size), Record.data(), Size);
+		this->Header->Head.store(Head + Needed, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Appends a record, waiting for the reader to make room if it must.
+	 * @param Record The bytes to write
+	 * @param Reader The process reading the ring. If it goes away while waiting for room, this gives up.
+	 * @return Whether the record was written. This fails if it could never fit, or if the reader is gone.
+	 */
+	bool Push(const std::vector<uint8_t> &Record, pid_t Reader)
+	{
+		if (!this->Fits(Record))
+		{
+			return false;
+		}
+
+		while (!this->TryPush(Record))
+		{
+			if (getppid() != Reader)
+			{
+				return false;
+			}
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Takes the oldest record, if there is one.
+	 * @param Record Where to put the bytes of the record
+	 * @return Whether there was a record
+	 */
+	bool Pop(std::vector<uint8_t> &Record)
+	{
+		const uint64_t Tail = this->Header->Tail.load(std::memory_order_relaxed);
+		if (this->Header->Head.load(std::memory_order_acquire) == Tail)
+		{
+			return false;
+		}
+
+		uint64_t Size = 0;
+		this->Paste(Tail, &Size, sizeof(Size));
+		Record.resize(Size);
+		this->Paste(Tail + sizeof(Size), Record.data(), Size);
+		this->Header->Tail.store(Tail + sizeof(Size) + Size, std::memory_order_release);
+		return true;
+	}
+
+private:
+	void Copy(uint64_t Pos, const void *Src, uint64_t Size)
+	{
+		const uint8_t *Bytes = static_cast<const uint8_t*>(Src);
+		const uint64_t Offset = Pos % this->Capacity;
+		const uint64_t First = (Size < this->Capacity - Offset) ? Size : (this->Capacity - Offset);
+		std::memcpy(this->Data + Offset, Bytes, First);
+		std::memcpy(this->Data, Bytes + First, Size - First);
+	}
+
+	void Paste(uint64_t Pos, void *Dst, uint64_t Size) const
+	{
+		uint8_t *Bytes = static_cast<uint8_t*>(Dst);
+		const uint64_t Offset = Pos % this->Capacity;
+		const uint64_t First = (Size < this->Capacity - Offset) ? Size : (this->Capacity - Offset);
+		std::memcpy(Bytes, this->Data + Offset, First);
+		std::memcpy(Bytes + First, this->Data, Size - First);
+	}
+
+	RingHeader *Header;
+	uint8_t *Data;
+	uint64_t Capacity;
+};
+
+/**
+ * @brief A name for a new shared memory object, which no other in this or any other process has.
+ */
+inline std::string SharedName()
+{
+	static std::atomic<uint64_t> Count = 0;
+	return "/domain-" + std::to_string(getpid()) + "-" + std::to_string(Count.fetch_add(1));
+}
+
+/**
+ * @brief How a side of a ring waits for the other: by yielding at first, since an answer usually comes soon, and then
+ * by sleeping, so that an idle process doesn't keep a CPU busy.
+ */
+class Backoff
+{
+public:
+	void Wait()
+	{
+		if (this->Misses < 256)
+		{
+			this->Misses++;
+			std::this_thread::yield();
+			return;
+		}
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+	}
+
+	void Reset()
+	{
+		this->Misses = 0;
+	}
+
+private:
+	uint64_t Misses = 0;
+};
+
+/**
+ * @brief What a record sent between the search and one of its worker processes is, written as its first word.
+ * @details For every generation, the search sends a worker Slice (with the number of configurations in it), a Batch for
+ * each batch of them, and then End. The worker answers with Results for every batch it evaluated, followed by Done.
+ * Quit tells an idle worker to exit.
+ */
+enum class WorkerMessage : uint64_t
+{
+	Slice,
+	Batch,
+	End,
+	Quit,
+	Results,
+	Done
+};
+
+}
+
+/**
+ * @brief Evaluates each slice of a generation in its own process, forked from the one running the search.
+ * @details One worker process is forked per slice when the first generation is executed, and they stay until Finish.
+ * Since each is a copy of the search as it was then, it already has the function and every setting of the search, and
+ * only the configurations of each generation have to be sent to it. Each worker has its own heap and its own MPFR state,
+ * so nothing is contended between them, and a crash in one can't corrupt the others.
+ *
+ * Every worker has two rings in POSIX shared memory: one which the search sends it configurations through, a batch at a
+ * time, and one which it sends the results of each batch back through, as it goes. Both sides work on a batch as soon as
+ * it arrives, so a generation costs about as much as it would with threads, plus copying each configuration to and from
+ * the rings. For a single worker, handing it an empty slice and hearing back takes around 20 us, where forking a worker
+ * for every generation took around 0.6 ms (see ProcessExecutor::Execute in bench-primitives), more than evaluating
+ * a small generation does.
+ * The search passes every batch of results to Job.Record, so the stopping policy, the incumbent, and the splitting policy
+ * all see them just as they would with threads. Each worker times its own batches, and the search passes that to Job.Busy,
+ * so traces, timelines, and profiles show each worker's time as if it were a thread. If the search should stop, the workers are told to through a flag in the
+ * same shared memory. The errors each worker counts for the distribution (see ErrorStatistics) are sent with its results.
+ *
+ * If a worker dies, whether it crashed or had to give up because it could no longer send its results, whatever it hadn't
+ * sent back is evaluated by the process running the search instead, and a new worker is forked for the next generation.
+ * The same is done for slices which can't be sent to a worker at all, such as when a worker can't be forked.
+ *
+ * Workers don't see each other's results while running, so pruning is only against the best result of the same worker.
+ * Since only the forking thread exists in a worker, the search should not be run while other threads of the process hold
+ * locks a worker might need; in particular, this is not meant to be combined with a ThreadExecutor or MPI in the same process.
+ * An executor may be reused by several searches one after the other, but since the workers are copies of the first, every
+ * Execute from the first up to Finish must be for the same search.
+ * @author Brian Schnepp
+ */
+template<typename T>
+class ProcessExecutor
+{
+public:
+	using Configuration = std::unordered_map<uint64_t, bgrt::Variable<T>>;
+
+	/**
+	 * @brief Sets up the shared memory for the workers. No process is created until there is work to do.
+	 * @param NumProcs The number of worker processes to use for finding error. 0 (default) gets one per hardware thread.
+	 * @param RingBytes The size of each ring to and from a worker. Default is 1 MiB, much more than any batch needs.
+	 */
+	ProcessExecutor(uint64_t NumProcs = 0, uint64_t RingBytes = 1 << 20)
+	{
+		if (NumProcs == 0)
+		{
+			NumProcs = std::thread::hardware_concurrency();
+		}
+		this->NumProcs = (NumProcs == 0) ? 1 : NumProcs;
+		this->Children.assign(this->NumProcs, 0);
+
+		/* Rings start on a cache line, so that no two of them write to the same one. */
+		this->RingBytes = (RingBytes + 63) & ~(uint64_t)63;
+		this->RingStride = sizeof(impl::RingHeader) + this->RingBytes;
+		this->MapSize = 64 + (2 * this->NumProcs * this->RingStride);
+
+		/* The name is only needed long enough to map it: once unlinked, the memory goes away with the last process using it. */
+		std::string Name = impl::SharedName();
+		int FD = shm_open(Name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+		if (FD < 0)
+		{
+			return;
+		}
+		shm_unlink(Name.c_str());
+
+		if (ftruncate(FD, (off_t)this->MapSize) == 0)
+		{
+			void *Map = mmap(nullptr, this->MapSize, PROT_READ | PROT_WRITE, MAP_SHARED, FD, 0);
+			this->Map = (Map == MAP_FAILED) ? nullptr : static_cast<uint8_t*>(Map);
+		}
+		close(FD);
+
+		if (this->Map != nullptr)
+		{
+			this->Stop = new (this->Map) std::atomic<uint32_t>(0);
+			for (uint64_t Ring = 0; Ring < 2 * this->NumProcs; Ring++)
+			{
+				uint8_t *Base = this->Map + 64 + (Ring * this->RingStride);
+				impl::RingHeader *Header = new (Base) impl::RingHeader{};
+				std::vector<impl::SharedRing> &Rings = (Ring < this->NumProcs) ? this->Inboxes : this->Outboxes;
+				Rings.emplace_back(Header, Base + sizeof(impl::RingHeader), this->RingBytes);
+			}
+		}
+	}
+
+	~ProcessExecutor()
+	{
+		this->Retire();
+		if (this->Map != nullptr)
+		{
+			munmap(this->Map, this->MapSize);
+		}
+	}
+
+	ProcessExecutor(const ProcessExecutor &Other) = delete;
+	ProcessExecutor &operator=(const ProcessExecutor &Other) = delete;
+
+	uint64_t Workers() const
+	{
+		return this->NumProcs;
+	}
+
+	/**
+	 * @brief Whether workers can be used at all. If not (such as if no shared memory is available), every slice is
+	 * evaluated in this process, one after the other.
+	 */
+	bool Usable() const
+	{
+		return this->Map != nullptr;
+	}
+
+	/**
+	 * @brief How many times a worker has died before finishing its slice, leaving the rest of it to this process.
+	 */
+	uint64_t Losses() const
+	{
+		return this->Lost;
+	}
+
+	template<typename ProduceFn>
+	void Generate(std::vector<std::vector<Configuration>> &Parts, ProduceFn &Produce)
+	{
+		for (uint64_t TID = 0; TID < Parts.size(); TID++)
+		{
+			Parts[TID].clear();
+			Produce(TID, Parts[TID]);
+		}
+	}
+
+	template<typename Job>
+	void Execute(const std::vector<std::vector<Configuration>> &Parts, std::vector<impl::WorkerResult<T>> &Results, Job &Evaluate)
+	{
+		/* The first configuration of each slice which no worker has evaluated. */
+		std::vector<uint64_t> Next(this->NumProcs, 0);
+		for (impl::WorkerResult<T> &Res : Results)
+		{
+			Res.Best = EvalResults{};
+			Res.Conf.clear();
+		}
+
+		if (this->Usable())
+		{
+			this->Stop->store(0, std::memory_order_relaxed);
+			this->Spawn(Evaluate);
+			this->Collect(Parts, Results, Evaluate, Next);
+		}
+
+		/* Anything a worker couldn't be given, or didn't get to before it died, is done here instead. */
+		for (uint64_t TID = 0; TID < this->NumProcs; TID++)
+		{
+			impl::RunRange<T>(TID, Parts[TID], Next[TID], Results[TID], Evaluate);
+		}
+	}
+
+	template<typename FilterFn>
+	bool Share(EvalResults &/* LocalError */, Configuration &/* LocalConf */, Configuration &/* Base */,
+		const FilterFn &/* Accept */)
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Tells every worker to exit, and waits for them to, so that the next search forks its own.
+	 */
+	void Finish(EvalResults &/* WorstError */)
+	{
+		this->Retire();
+	}
+
+private:
+	/**
+	 * @brief How far the search is with sending one worker its slice of the current generation.
+	 */
+	typedef struct Handoff
+	{
+		/* The number of configurations sent so far */
+		uint64_t Sent = 0;
+
+		/* The record which is to be sent next, the number of configurations in it, and whether it has been made yet */
+		impl::Serializer Next;
+		uint64_t Count = 0;
+		bool Queued = false;
+
+		/* Whether the worker has been sent Slice, and End */
+		bool Begun = false;
+		bool Ended = false;
+
+		/* Whether the worker is done with the slice, either by saying so or by going away */
+		bool Finished = false;
+	}Handoff;
+
+	/**
+	 * @brief Forks a worker for every slice which doesn't have one yet. Slices whose worker can't be forked are left to this
+	 * process until Finish.
+	 * @details Every worker starts with a copy of this process's generator, so each is reseeded first: otherwise every
+	 * worker would sample the same points within its boxes.
+	 */
+	template<typename Job>
+	void Spawn(Job &Evaluate)
+	{
+		const pid_t Parent = getpid();
+		for (uint64_t TID = 0; TID < this->NumProcs; TID++)
+		{
+			if (this->Children[TID] != 0)
+			{
+				continue;
+			}
+
+			this->Inboxes[TID].Reset();
+			this->Outboxes[TID].Reset();
+			const uint64_t Seed = this->Seeds();
+			const pid_t Child = fork();
+			if (Child == 0)
+			{
+				this->Work(TID, Evaluate, Parent, Seed);
+			}
+			this->Children[TID] = Child;
+		}
+	}
+
+	/**
+	 * @brief The whole life of a worker process: evaluating every batch it is sent, until it's told to quit. This never returns.
+	 */
+	template<typename Job>
+	[[noreturn]] void Work(uint64_t TID, Job &Evaluate, pid_t Parent, uint64_t Seed)
+	{
+		bgrt::Reseed(Seed);
+		impl::SharedRing &Inbox = this->Inboxes[TID];
+		impl::SharedRing &Outbox = this->Outboxes[TID];
+
+		std::vector<Configuration> Slice;
+		std::vector<EvalResults> Out;
+		std::vector<uint8_t> Record;
+		impl::Serializer Writer;
+		impl::Backoff Idle;
+		while (true)
+		{
+			if (!Inbox.Pop(Record))
+			{
+				/* The search went away without saying so. */
+				if (getppid() != Parent)
+				{
+					_exit(1);
+				}
+				Idle.Wait();
+				continue;
+			}
+			Idle.Reset();
+
+			impl::Deserializer Reader(Record);
+			uint64_t Kind = 0;
+			uint64_t Begin = 0;
+			uint64_t Count = 0;
+			Reader.Read(Kind);
+			if (Kind == (uint64_t)impl::WorkerMessage::Quit)
+			{
+				/* Skip every destructor and exit handler: they belong to the process which forked this one. */
+				_exit(0);
+			}
+
+			Writer.Clear();
+			if (Kind == (uint64_t)impl::WorkerMessage::Slice && Reader.Read(Count))
+			{
+				Slice.resize(Count);
+				Evaluate.Forget(TID);
+				continue;
+			}
+			else if (Kind == (uint64_t)impl::WorkerMessage::End)
+			{
+				Writer.Write((uint64_t)impl::WorkerMessage::Done);
+			}
+			else if (Kind == (uint64_t)impl::WorkerMessage::Batch && Reader.Read(Begin) && Reader.Read(Count)
+				&& Begin <= Slice.size() && Count <= Slice.size() - Begin)
+			{
+				for (uint64_t Index = Begin; Index < Begin + Count; Index++)
+				{
+					if (!Reader.Read(Slice[Index]))
+					{
+						_exit(1);
+					}
+				}
+
+				/* Batches after the search stopped are left unanswered, as RunSlice would leave them unevaluated. */
+				if (this->Stop->load(std::memory_order_relaxed) != 0 || Evaluate.Stopped())
+				{
+					continue;
+				}
+				const std::span<const Configuration> Batch(Slice.data() + Begin, Count);
+				PhaseProfile Spent{};
+				std::chrono::steady_clock::time_point Began;
+				Evaluate.Eval(TID, Batch, Out, Spent, Began);
+				Evaluate.Record(TID, Batch, Out);
+
+				Writer.Write((uint64_t)impl::WorkerMessage::Results);
+				Writer.Write(Begin);
+				Writer.Write(Count);
+				for (const EvalResults &Res : Out)
+				{
+					Writer.Write(Res);
+				}
+
+				/* The clock is the same in every process, so the search can place the batch on its own timeline. */
+				Writer.Write(Spent.Nanos);
+				Writer.Write(Spent.HeapAllocations);
+				Writer.Write(Spent.MPFRAllocations);
+				Writer.Write((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Began.time_since_epoch()).count());
+				ErrorStatistics *Dist = Evaluate.Distribution(TID);
+				Writer.Write((uint64_t)(Dist != nullptr));
+				if (Dist != nullptr)
+				{
+					Writer.Write(*Dist);
+					Dist->Clear();
+				}
+			}
+			else
+			{
+				_exit(1);
+			}
+
+			if (!Outbox.Push(Writer.Bytes(), Parent))
+			{
+				_exit(1);
+			}
+		}
+	}
+
+	/**
+	 * @brief Sends a worker as much of its slice as its ring has room for, then End once all of it is sent, or once the
+	 * search has stopped. A batch too large for the ring is left for this process, along with the rest of the slice.
+	 * @return Whether anything was sent
+	 */
+	bool Feed(impl::SharedRing &Ring, const std::vector<Configuration> &Slice, Handoff &Hand, bool Stopping)
+	{
+		bool Moved = false;
+		while (!Hand.Ended)
+		{
+			if (!Hand.Queued)
+			{
+				Hand.Next.Clear();
+				Hand.Count = 0;
+				if (!Hand.Begun)
+				{
+					Hand.Next.Write((uint64_t)impl::WorkerMessage::Slice);
+					Hand.Next.Write((uint64_t)Slice.size());
+				}
+				else if (!Stopping && Hand.Sent < Slice.size())
+				{
+					Hand.Count = (Slice.size() - Hand.Sent < impl::BatchSize) ? (Slice.size() - Hand.Sent) : impl::BatchSize;
+					Hand.Next.Write((uint64_t)impl::WorkerMessage::Batch);
+					Hand.Next.Write(Hand.Sent);
+					Hand.Next.Write(Hand.Count);
+					for (uint64_t Index = Hand.Sent; Index < Hand.Sent + Hand.Count; Index++)
+					{
+						Hand.Next.Write(Slice[Index]);
+					}
+				}
+
+				if (Hand.Begun && (Hand.Count == 0 || !Ring.Fits(Hand.Next.Bytes())))
+				{
+					Hand.Next.Clear();
+					Hand.Count = 0;
+					Hand.Next.Write((uint64_t)impl::WorkerMessage::End);
+				}
+				Hand.Queued = true;
+			}
+
+			if (!Ring.TryPush(Hand.Next.Bytes()))
+			{
+				break;
+			}
+			Moved = true;
+			Hand.Queued = false;
+			Hand.Ended = Hand.Begun && (Hand.Count == 0);
+			Hand.Begun = true;
+			Hand.Sent += Hand.Count;
+		}
+		return Moved;
+	}
+
+	/**
+	 * @brief Sends every worker its slice, and reads back its results until every worker is done with its slice or has died,
+	 * reducing them the same way RunSlice does.
+	 * @param Next Set to the first configuration of each slice which was not evaluated by its worker
+	 */
+	template<typename Job>
+	void Collect(const std::vector<std::vector<Configuration>> &Parts, std::vector<impl::WorkerResult<T>> &Results,
+		Job &Evaluate, std::vector<uint64_t> &Next)
+	{
+		std::vector<Handoff> Hands(this->NumProcs);
+		uint64_t Running = 0;
+		for (uint64_t TID = 0; TID < this->NumProcs; TID++)
+		{
+			Hands[TID].Finished = this->Children[TID] <= 0;
+			Running += Hands[TID].Finished ? 0 : 1;
+		}
+
+		std::vector<uint8_t> Record;
+		std::vector<EvalResults> Batch;
+		ErrorStatistics Seen;
+		impl::Backoff Idle;
+		while (Running > 0)
+		{
+			const bool Stopping = Evaluate.Stopped();
+			if (Stopping)
+			{
+				this->Stop->store(1, std::memory_order_relaxed);
+			}
+
+			bool Progress = false;
+			for (uint64_t TID = 0; TID < this->NumProcs; TID++)
+			{
+				Handoff &Hand = Hands[TID];
+				if (Hand.Finished)
+				{
+					continue;
+				}
+				Progress = this->Feed(this->Inboxes[TID], Parts[TID], Hand, Stopping) || Progress;
+
+				/* A worker writes everything before it exits, so whatever is left after that is the last of it. */
+				int Status = 0;
+				const bool Exited = waitpid(this->Children[TID], &Status, WNOHANG) == this->Children[TID];
+				while (!Hand.Finished && this->Outboxes[TID].Pop(Record))
+				{
+					Progress = true;
+					Hand.Finished = this->Replay(TID, Parts[TID], Record, Batch, Seen, Results[TID], Evaluate, Next[TID]);
+				}
+
+				/* Workers only exit cleanly when told to quit, so any other exit loses whatever it hadn't sent back. */
+				if (Exited)
+				{
+					this->Lost += (!Hand.Finished || !WIFEXITED(Status) || WEXITSTATUS(Status) != 0) ? 1 : 0;
+					this->Children[TID] = 0;
+					Hand.Finished = true;
+				}
+				Running -= Hand.Finished ? 1 : 0;
+			}
+
+			if (Progress)
+			{
+				Idle.Reset();
+			}
+			else if (Running > 0)
+			{
+				Idle.Wait();
+			}
+		}
+	}
+
+	/**
+	 * @brief Passes the results of a batch a worker evaluated on to the job, and counts them in the slice's summary.
+	 * @return Whether this was the last record of the worker's slice
+	 */
+	template<typename Job>
+	bool Replay(uint64_t TID, const std::vector<Configuration> &Slice, const std::vector<uint8_t> &Record,
+		std::vector<EvalResults> &Batch, ErrorStatistics &Seen, impl::WorkerResult<T> &Out, Job &Evaluate, uint64_t &Next)
+	{
+		impl::Deserializer Reader(Record);
+		uint64_t Kind = 0;
+		uint64_t Begin = 0;
+		uint64_t Count = 0;
+		uint64_t Counted = 0;
+		if (!Reader.Read(Kind) || Kind == (uint64_t)impl::WorkerMessage::Done)
+		{
+			return true;
+		}
+		if (!Reader.Read(Begin) || !Reader.Read(Count) || Begin > Slice.size() || Count > Slice.size() - Begin)
+		{
+			return false;
+		}
+
+		Batch.resize(Count);
+		for (EvalResults &Res : Batch)
+		{
+			if (!Reader.Read(Res))
+			{
+				return false;
+			}
+		}
+		PhaseProfile Spent{};
+		uint64_t Began = 0;
+		if (!Reader.Read(Spent.Nanos) || !Reader.Read(Spent.HeapAllocations) || !Reader.Read(Spent.MPFRAllocations)
+			|| !Reader.Read(Began))
+		{
+			return false;
+		}
+		if (!Reader.Read(Counted) || (Counted != 0 && !Reader.Read(Seen)))
+		{
+			return false;
+		}
+
+		ErrorStatistics *Dist = Evaluate.Distribution(TID);
+		if (Counted != 0 && Dist != nullptr)
+		{
+			Dist->Merge(Seen);
+		}
+		Evaluate.Busy(TID, Count, Spent, std::chrono::steady_clock::time_point(std::chrono::nanoseconds(Began)));
+		Evaluate.Record(TID, std::span<const Configuration>(Slice.data() + Begin, Count), Batch);
+		for (uint64_t Index = 0; Index < Count; Index++)
+		{
+			if (Batch[Index].Err > Out.Best.Err)
+			{
+				Out.Best = Batch[Index];
+				Out.Conf = Slice[Begin + Index];
+			}
+		}
+		Next = (Begin + Count > Next) ? (Begin + Count) : Next;
+		return false;
+	}
+
+	/**
+	 * @brief Tells every worker to quit, and waits for them all to. Any worker which can't be told is killed instead.
+	 */
+	void Retire()
+	{
+		impl::Serializer Writer;
+		Writer.Write((uint64_t)impl::WorkerMessage::Quit);
+		for (uint64_t TID = 0; TID < this->NumProcs; TID++)
+		{
+			if (this->Children[TID] > 0)
+			{
+				if (!this->Inboxes[TID].TryPush(Writer.Bytes()))
+				{
+					kill(this->Children[TID], SIGKILL);
+				}
+				waitpid(this->Children[TID], nullptr, 0);
+			}
+			this->Children[TID] = 0;
+		}
+	}
+
+	uint64_t NumProcs;
+	uint64_t RingBytes;
+	uint64_t RingStride;
+	uint64_t MapSize;
+
+	uint8_t *Map = nullptr;
+	std::atomic<uint32_t> *Stop = nullptr;
+	std::vector<impl::SharedRing> Inboxes;
+	std::vector<impl::SharedRing> Outboxes;
+
+	/* The worker of each slice: 0 if none has been forked yet (or the last one died), or -1 if it couldn't be. */
+	std::vector<pid_t> Children;
+	uint64_t Lost = 0;
+
+	/* Where each worker's seed is drawn from, so that no two workers sample alike. */
+	std::mt19937_64 Seeds{std::random_device{}()};
+};
+
+/**
+ * @brief Implements a multi-process variant of the BGRT algorithm to efficiently find floating point errors, for when MPI isn't available
+ * @author Brian Schnepp
+ * @see https://formalverification.cs.utah.edu/grt/publications/ppopp14-s3fp.pdf
+ * @param InitConf The initial BGRT variable configuration
+ * @param Iterations The number of configurations to create upon every previous configuration given
+ * @param Resources The rough limit on the number of floating point computations to perform. Actual executions may exceed this value by a fair amount.
+ * @param RestartPercent The percentage, as a whole integer, where the initial configuration is reset to avoid local minima
+ * @param F The function which takes a BGRT configuration to check for floating-point error with.
+ * @param k The number of times to execute F, looking for potential error
+ * @param LogFreq Chance (out of 10000) that a log is printed after any given generation. Default is 5000.
+ * @param LogOut A stream to send messages to for logging. Default is std::cout.
+ * @param Options How to run the search, and what else to report. NumThreads is the number of worker processes, and
+ * PinThreads is ignored. See SearchOptions.
+ * @return The highest error of the function that was ever found, described as "WorstError" in the paper
+ */
+template<typename T>
+EvalResults FindErrorMultiprocess(const std::unordered_map<uint64_t, bgrt::Variable<T>> &InitConf,
+		std::unordered_map<uint64_t, dom::Value<T>> (*F)(std::unordered_map<uint64_t, dom::Value<T>>&),
+		const uint64_t Iterations = 100, const int64_t Resources = INT32_MAX, const uint64_t RestartPercent = 5,
+		uint64_t k = 1000, uint64_t LogFreq = 5000, std::ostream &LogOut = std::cout, const SearchOptions &Options = {})
+{
+	dom::ProcessExecutor<T> Exec(Options.NumThreads);
+	dom::SearchEngine<T, dom::ShadowOpBudget, dom::AcceptAll, dom::RandomRestart, dom::ProcessExecutor<T>> Engine(F, Exec,
+		dom::ShadowOpBudget{Resources}, dom::AcceptAll{}, dom::RandomRestart{RestartPercent}, Iterations, k, LogFreq, LogOut);
+	return Engine.Run(InitConf, Options);
+}
+
+}
+
+#endif
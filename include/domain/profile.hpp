@@ -0,0 +1,193 @@
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+#ifndef DOMAIN_PROFILE_HPP_
+#define DOMAIN_PROFILE_HPP_
+
+/**
+ * @file include/domain/profile.hpp
+ * @brief Where a search spends its time and allocations, measured only when libdomain is built with DOMAIN_PROFILE
+ */
+
+namespace dom
+{
+
+/**
+ * @brief The time and allocations spent in one phase of a search.
+ */
+typedef struct PhaseProfile
+{
+	/* Nanoseconds spent in the phase */
+	uint64_t Nanos;
+
+	/* The number of allocations made through operator new during the phase */
+	uint64_t HeapAllocations;
+
+	/* The number of allocations (and reallocations) made by MPFR, through GMP, during the phase */
+	uint64_t MPFRAllocations;
+}PhaseProfile;
+
+/**
+ * @brief How a search split its time and allocations between the phases of every generation.
+ * @details This is only measured when libdomain is built with DOMAIN_PROFILE (see the CMake option of the same name).
+ * Otherwise, nothing is timed or counted, and every field is 0.
+ *
+ * Eval and Idle are summed over every worker, so with several workers they may add up to more than the time of the search.
+ * So are Generate and Filter, when pinned workers make their own slices (see ThreadExecutor).
+ * Workers of a ProcessExecutor run in other processes, and send back the time and allocations of each batch they evaluate.
+ */
+typedef struct SearchProfile
+{
+	/* Whether any of this was measured */
+	bool Enabled;
+
+	/* The number of generations measured */
+	uint64_t Generations;
+
+	/* Making the children of each generation (BGRTState::NextGen, and partitioning them between workers), not counting Filter */
+	PhaseProfile Generate;
+
+	/* Asking the filtering policy about each child */
+	PhaseProfile Filter;
+
+	/* Evaluating children, summed over every worker */
+	PhaseProfile Eval;
+
+	/* Nanoseconds workers spent waiting for the others to finish each generation, summed over every worker */
+	uint64_t Idle;
+
+	/* Combining the results of every worker: the running totals, the splitting policy, picking the worst child, and
+	 * moving the BGRT state to it (BGRTState::SetVals), including anything the executor shares with other searches.
+	 */
+	PhaseProfile Reduce;
+}SearchProfile;
+
+namespace impl
+{
+
+#if defined(DOMAIN_PROFILE)
+inline constexpr bool Profiling = true;
+#else
+inline constexpr bool Profiling = false;
+#endif
+
+/* Counted by the allocators Lib.cpp installs when profiling, separately on every thread so counting never contends. */
+inline thread_local uint64_t HeapAllocations = 0;
+inline thread_local uint64_t MPFRAllocations = 0;
+
+/**
+ * @brief Adds the time and allocations of one phase to another.
+ */
+inline void Accumulate(PhaseProfile &Into, const PhaseProfile &Add)
+{
+	Into.Nanos += Add.Nanos;
+	Into.HeapAllocations += Add.HeapAllocations;
+	Into.MPFRAllocations += Add.MPFRAllocations;
+}
+
+/**
+ * @brief Adds a whole search's profile to another, such as to sum up several searches.
+ */
+inline void Accumulate(SearchProfile &Into, const SearchProfile &Add)
+{
+	Into.Enabled = Into.Enabled || Add.Enabled;
+	Into.Generations += Add.Generations;
+	Accumulate(Into.Generate, Add.Generate);
+	Accumulate(Into.Filter, Add.Filter);
+	Accumulate(Into.Eval, Add.Eval);
+	Into.Idle += Add.Idle;
+	Accumulate(Into.Reduce, Add.Reduce);
+}
+
+/**
+ * @brief Takes back from a phase whatever another phase grew by, for a phase which is nested in it.
+ * @param Outer The enclosing phase
+ * @param Inner The nested phase, as of now
+ * @param Before The nested phase, as of when the enclosing one began
+ */
+inline void Exclude(PhaseProfile &Outer, const PhaseProfile &Inner, const PhaseProfile &Before)
+{
+	Outer.Nanos -= Inner.Nanos - Before.Nanos;
+	Outer.HeapAllocations -= Inner.HeapAllocations - Before.HeapAllocations;
+	Outer.MPFRAllocations -= Inner.MPFRAllocations - Before.MPFRAllocations;
+}
+
+/**
+ * @brief Measures a phase from when it is made until Stop (or its destructor), and adds it to a PhaseProfile.
+ * @details The time is always measured. Allocations are only counted when profiling, since nothing counts them otherwise.
+ * Allocations are counted on the calling thread, so the phase must begin and end on the same one.
+ * @author Brian Schnepp
+ */
+class PhaseTimer
+{
+public:
+	explicit PhaseTimer(PhaseProfile &Into) : Into(&Into), Begin(std::chrono::steady_clock::now()),
+		Heap(HeapAllocations), MPFR(MPFRAllocations)
+	{
+	}
+
+	~PhaseTimer()
+	{
+		this->Stop();
+	}
+
+	PhaseTimer(const PhaseTimer &Other) = delete;
+	PhaseTimer &operator=(const PhaseTimer &Other) = delete;
+
+	/**
+	 * @brief When the phase began.
+	 */
+	std::chrono::steady_clock::time_point Began() const
+	{
+		return this->Begin;
+	}
+
+	/**
+	 * @brief Ends the phase early. Only the first call does anything.
+	 */
+	void Stop()
+	{
+		if (this->Into == nullptr)
+		{
+			return;
+		}
+		const std::chrono::nanoseconds Elapsed = std::chrono::steady_clock::now() - this->Begin;
+		this->Into->Nanos += (uint64_t)Elapsed.count();
+		this->Into->HeapAllocations += HeapAllocations - this->Heap;
+		this->Into->MPFRAllocations += MPFRAllocations - this->MPFR;
+		this->Into = nullptr;
+	}
+
+private:
+	PhaseProfile *Into;
+	std::chrono::steady_clock::time_point Begin;
+	uint64_t Heap;
+	uint64_t MPFR;
+};
+
+/**
+ * @brief Stands in for a PhaseTimer when not profiling, so that it compiles away entirely.
+ */
+class NoPhase
+{
+public:
+	explicit NoPhase(PhaseProfile &/* Into */)
+	{
+	}
+
+	void Stop()
+	{
+	}
+};
+
+/**
+ * @brief Measures a phase only when profiling.
+ */
+using ScopedPhase = std::conditional_t<Profiling, PhaseTimer, NoPhase>;
+
+}
+
+}
+
+#endif
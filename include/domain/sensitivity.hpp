@@ -0,0 +1,164 @@
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <value.hpp>
+#include <hpfloat.hpp>
+#include <bgrt/bgrt.hpp>
+
+#include "impl/tape.hpp"
+
+#ifndef DOMAIN_SENSITIVITY_HPP_
+#define DOMAIN_SENSITIVITY_HPP_
+
+/**
+ * @file include/domain/sensitivity.hpp
+ * @brief Derivatives of a function's outputs with respect to its inputs, to find which inputs amplify error the most
+ */
+
+namespace dom
+{
+
+/**
+ * @brief How much one output depends on one input, over the points it was sampled at.
+ */
+typedef struct InputSensitivity
+{
+	/* The average of the derivative of the output with respect to the input */
+	double Gradient;
+
+	/* The largest magnitude of the derivative */
+	double MaxGradient;
+
+	/* The largest condition number |(dy/dx) * (x / y)|, or how much a relative change in x is amplified in y */
+	double Condition;
+}InputSensitivity;
+
+/**
+ * @brief The sensitivity of every output of a function to every one of its inputs.
+ * @author Brian Schnepp
+ */
+typedef struct SensitivityReport
+{
+	/* By key of the output, then by key of the input */
+	std::unordered_map<uint64_t, std::unordered_map<uint64_t, InputSensitivity>> Outputs;
+
+	/* The number of points the function was sampled at */
+	uint64_t Samples;
+
+	/**
+	 * @brief Turns the report into a bias for BGRTState::SetBias.
+	 * @details Each input is weighted by its largest condition number over all outputs, relative to the largest of any input.
+	 * Inputs whose derivative (for that output) is positive lean toward the first group, and negative ones toward the second,
+	 * so that the inputs which matter most are moved together in whichever direction grows the output.
+	 * Inputs which barely matter are left close to even odds.
+	 * @return The chance of each input being placed into the first group by PartConf
+	 */
+	std::unordered_map<uint64_t, double> Bias() const
+	{
+		std::unordered_map<uint64_t, double> Score;
+		std::unordered_map<uint64_t, double> Sign;
+		double MaxScore = 0.0;
+		for (const auto &Out : this->Outputs)
+		{
+			for (const auto &In : Out.second)
+			{
+				double &Best = Score[In.first];
+				if (In.second.Condition >= Best)
+				{
+					Best = In.second.Condition;
+					Sign[In.first] = (In.second.Gradient > 0) ? 1.0 : ((In.second.Gradient < 0) ? -1.0 : 0.0);
+				}
+				MaxScore = (Best > MaxScore) ? Best : MaxScore;
+			}
+		}
+
+		std::unordered_map<uint64_t, double> RetVal;
+		for (const auto &Pair : Score)
+		{
+			double Weight = (MaxScore > 0 && std::isfinite(MaxScore)) ? (Pair.second / MaxScore) : 0.0;
+			RetVal[Pair.first] = 0.5 + 0.5 * Sign[Pair.first] * Weight;
+		}
+		return RetVal;
+	}
+}SensitivityReport;
+
+/**
+ * @brief Measures how sensitive each output of P is to each of its inputs, across a configuration.
+ * @details P is run at several random points within C while recording a tape of every operation on its Values. The derivatives
+ * are then found by reverse mode (one sweep per output) or forward mode (one sweep per input), whichever needs fewer sweeps.
+ * Only arithmetic on Values is seen: anything P computes by converting to and from plain numbers is treated as a constant.
+ * @author Brian Schnepp
+ * @param P The function to analyze
+ * @param C The ranges of each input to sample within
+ * @param Samples How many points to sample P at
+ * @return The sensitivity of each output to each input
+ */
+template<typename T>
+SensitivityReport Sensitivity(std::unordered_map<uint64_t, dom::Value<T>> (*P)(std::unordered_map<uint64_t, dom::Value<T>>&),
+	const std::unordered_map<uint64_t, bgrt::Variable<T>> &C, uint64_t Samples = 16)
+{
+	using Array = std::unordered_map<uint64_t, dom::Value<T>>;
+
+	SensitivityReport RetVal;
+	RetVal.Samples = Samples;
+
+	impl::Tape Rec;
+	Array Inputs;
+	std::unordered_map<uint64_t, uint32_t> Leaves;
+	for (uint64_t Sample = 0; Sample < Samples; Sample++)
+	{
+		Rec.Clear();
+		impl::ScopedTape Recording(Rec);
+
+		for (const auto &Pair : C)
+		{
+			Inputs[Pair.first] = Pair.second.Sample();
+			Leaves[Pair.first] = Inputs[Pair.first].Track();
+		}
+		const Array Outputs = P(Inputs);
+
+		/* Forward mode needs one sweep per input, and reverse mode one sweep per output. */
+		std::unordered_map<uint64_t, std::vector<double>> Sweeps;
+		const bool UseReverse = Outputs.size() <= Leaves.size();
+		if (UseReverse)
+		{
+			for (const auto &Out : Outputs)
+			{
+				Sweeps[Out.first] = Rec.Reverse(Out.second.TapeNode());
+			}
+		}
+		else
+		{
+			for (const auto &Leaf : Leaves)
+			{
+				Sweeps[Leaf.first] = Rec.Forward(Leaf.second);
+			}
+		}
+
+		for (const auto &Out : Outputs)
+		{
+			double Y = mpfr_get_d(Out.second.SVal().mpfr_srcptr(), MPFR_RNDN);
+			for (const auto &Leaf : Leaves)
+			{
+				double Grad = UseReverse ? Sweeps[Out.first][Leaf.second] : Sweeps[Leaf.first][Out.second.TapeNode()];
+				double X = mpfr_get_d(Inputs[Leaf.first].SVal().mpfr_srcptr(), MPFR_RNDN);
+
+				InputSensitivity &Sens = RetVal.Outputs[Out.first][Leaf.first];
+				Sens.Gradient += Grad / Samples;
+				Sens.MaxGradient = (std::fabs(Grad) > Sens.MaxGradient) ? std::fabs(Grad) : Sens.MaxGradient;
+				if (Y != 0.0)
+				{
+					double Cond = std::fabs(Grad * X / Y);
+					Sens.Condition = (Cond > Sens.Condition) ? Cond : Sens.Condition;
+				}
+			}
+		}
+	}
+	return RetVal;
+}
+
+}
+
+#endif
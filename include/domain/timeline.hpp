@@ -0,0 +1,209 @@
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+
+#ifndef DOMAIN_TIMELINE_HPP_
+#define DOMAIN_TIMELINE_HPP_
+
+/**
+ * @file include/domain/timeline.hpp
+ * @brief A timeline of what every worker (and the coordinator) of a search was doing, written as a Chrome trace
+ */
+
+namespace dom
+{
+
+/**
+ * @brief One span of time on a timeline, such as a worker evaluating a batch.
+ */
+typedef struct TimelineEvent
+{
+	/* What was happening. This must be a string literal (or otherwise outlive the recorder). */
+	const char *Name;
+
+	/* Nanoseconds since the recorder was made, when the span began, and how long it lasted */
+	uint64_t Begin;
+	uint64_t Duration;
+
+	/* How many things (such as configurations) the span handled, or 0 if that doesn't apply */
+	uint64_t Items;
+}TimelineEvent;
+
+/**
+ * @brief Records what every worker of a search was doing, and when, in the Chrome trace_event format.
+ * @details Each worker has its own lane, and the coordinator (which makes and reduces each generation) has one after the
+ * workers. Every lane is a buffer only ever written by its owner, so recording a span takes no lock. Nothing is written
+ * out until Write, which the search engine calls once each search is over: open the file in Perfetto (https://ui.perfetto.dev)
+ * or chrome://tracing, and any gap in a worker's lane is time it spent waiting.
+ *
+ * A recorder may be reused by several searches, one after the other, which all go on the same timeline. It can't be shared
+ * between processes, though: with MPI, every rank needs a recorder with its own path.
+ * Workers of a ProcessExecutor run in other processes, but send back when they evaluated each batch, which the search records
+ * into their lanes here.
+ * @author Brian Schnepp
+ */
+class TimelineRecorder
+{
+public:
+	/**
+	 * @brief Creates an empty timeline.
+	 * @param Path Where to write the timeline. Anything already there is replaced.
+	 * @param Workers The number of workers of the executor of the search which will be recorded
+	 * @param Reserve How many spans to make room for in each lane up front. Default is 4096.
+	 */
+	TimelineRecorder(const char *Path, uint64_t Workers, uint64_t Reserve = 4096)
+		: Path(Path), Epoch(std::chrono::steady_clock::now()), Lanes(Workers + 1)
+	{
+		for (std::vector<TimelineEvent> &Lane : this->Lanes)
+		{
+			Lane.reserve(Reserve);
+		}
+	}
+
+	TimelineRecorder(const TimelineRecorder &Other) = delete;
+	TimelineRecorder &operator=(const TimelineRecorder &Other) = delete;
+
+	/**
+	 * @brief The lane of the coordinator, which is after every worker.
+	 */
+	uint64_t Coordinator() const
+	{
+		return this->Lanes.size() - 1;
+	}
+
+	/**
+	 * @brief Records a span. Only the owner of the lane may call this.
+	 * @param Lane The TID of the worker, or Coordinator(). Spans on any other lane are dropped.
+	 * @param Name What was happening, which must be a string literal
+	 * @param Begin When the span began
+	 * @param End When the span ended
+	 * @param Items How many things the span handled. Default is 0 (doesn't apply).
+	 */
+	void Record(uint64_t Lane, const char *Name, std::chrono::steady_clock::time_point Begin,
+		std::chrono::steady_clock::time_point End, uint64_t Items = 0)
+	{
+		if (Lane >= this->Lanes.size())
+		{
+			return;
+		}
+		const std::chrono::nanoseconds Since = Begin - this->Epoch;
+		const std::chrono::nanoseconds Length = End - Begin;
+		this->Lanes[Lane].push_back(TimelineEvent{Name, (uint64_t)Since.count(), (uint64_t)Length.count(), Items});
+	}
+
+	/**
+	 * @brief Writes every span recorded so far to the file, as Chrome trace_event JSON. Nobody may be recording at the time.
+	 * @return Whether the file could be written
+	 */
+	bool Write() const
+	{
+		std::ofstream Out(this->Path);
+		if (!Out)
+		{
+			return false;
+		}
+
+		/* Timestamps are in microseconds, kept to the nanosecond. */
+		Out << std::fixed << std::setprecision(3);
+		Out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+		for (uint64_t Lane = 0; Lane < this->Lanes.size(); Lane++)
+		{
+			Out << ((Lane == 0) ? "\n" : ",\n");
+			Out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << Lane << ",\"args\":{\"name\":\"";
+			if (Lane == this->Coordinator())
+			{
+				Out << "Coordinator";
+			}
+			else
+			{
+				Out << "Worker " << Lane;
+			}
+			Out << "\"}}";
+
+			for (const TimelineEvent &Event : this->Lanes[Lane])
+			{
+				Out << ",\n{\"name\":\"" << Event.Name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << Lane
+					<< ",\"ts\":" << (Event.Begin / 1000.0) << ",\"dur\":" << (Event.Duration / 1000.0);
+				if (Event.Items != 0)
+				{
+					Out << ",\"args\":{\"items\":" << Event.Items << "}";
+				}
+				Out << "}";
+			}
+		}
+		Out << "\n]}\n";
+		return (bool)Out;
+	}
+
+	/**
+	 * @brief Forgets every span recorded so far.
+	 */
+	void Clear()
+	{
+		for (std::vector<TimelineEvent> &Lane : this->Lanes)
+		{
+			Lane.clear();
+		}
+	}
+
+private:
+	std::string Path;
+	std::chrono::steady_clock::time_point Epoch;
+	std::vector<std::vector<TimelineEvent>> Lanes;
+};
+
+namespace impl
+{
+
+/**
+ * @brief Records a span on a timeline from when it is made until Stop (or its destructor), if there is a timeline at all.
+ * @author Brian Schnepp
+ */
+class TimelineSpan
+{
+public:
+	TimelineSpan(TimelineRecorder *Timeline, uint64_t Lane, const char *Name) : Timeline(Timeline), Lane(Lane), Name(Name)
+	{
+		if (this->Timeline != nullptr)
+		{
+			this->Begin = std::chrono::steady_clock::now();
+		}
+	}
+
+	~TimelineSpan()
+	{
+		this->Stop();
+	}
+
+	TimelineSpan(const TimelineSpan &Other) = delete;
+	TimelineSpan &operator=(const TimelineSpan &Other) = delete;
+
+	/**
+	 * @brief Ends the span early. Only the first call does anything.
+	 * @param Items How many things the span handled. Default is 0 (doesn't apply).
+	 */
+	void Stop(uint64_t Items = 0)
+	{
+		if (this->Timeline == nullptr)
+		{
+			return;
+		}
+		this->Timeline->Record(this->Lane, this->Name, this->Begin, std::chrono::steady_clock::now(), Items);
+		this->Timeline = nullptr;
+	}
+
+private:
+	TimelineRecorder *Timeline;
+	uint64_t Lane;
+	const char *Name;
+	std::chrono::steady_clock::time_point Begin;
+};
+
+}
+
+}
+
+#endif
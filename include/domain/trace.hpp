@@ -0,0 +1,255 @@
+#include <new>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#ifndef DOMAIN_TRACE_HPP_
+#define DOMAIN_TRACE_HPP_
+
+/**
+ * @file include/domain/trace.hpp
+ * @brief A compact binary log of every generation of a search, for plotting how it converges
+ */
+
+namespace dom
+{
+
+/**
+ * @brief What happened in one generation of a search.
+ * @details In the file, each record is followed by the busy time of every worker during the generation, in nanoseconds,
+ * as one uint64_t each: the time it spent evaluating configurations, wherever it ran. Workers of a ProcessExecutor measure
+ * their own, and send it back with the results of each batch. Every field is in the byte order of the machine which ran the
+ * search.
+ */
+typedef struct TraceRecord
+{
+	/* Nanoseconds since the search started, as of the end of the generation */
+	uint64_t Time;
+
+	/* The number of the generation, starting from 0 */
+	uint64_t Generation;
+
+	/* The number of configurations made from the state the generation started from, and how many passed the filter */
+	uint64_t Generated;
+	uint64_t Accepted;
+
+	/* The number of configurations evaluated during the generation. This may be fewer than Accepted if the search stopped early. */
+	uint64_t Evaluated;
+
+	/* The number of shadow value computations done so far, in total */
+	uint64_t ShadowOps;
+
+	/* The highest error of the generation, and of the search so far */
+	double LocalBest;
+	double GlobalBest;
+
+	/* Any of the TraceFlags */
+	uint64_t Flags;
+}TraceRecord;
+
+static_assert(sizeof(TraceRecord) == 72, "The trace file format depends on the size of a record");
+
+/**
+ * @brief Flags for TraceRecord::Flags.
+ */
+enum TraceFlags : uint64_t
+{
+	/* The generation started from the initial configuration: it is the first one, or the search restarted before it */
+	TRACE_FROM_INITIAL = 1,
+
+	/* After the generation, the search continued from a state found elsewhere (see Executor::Share) */
+	TRACE_ADOPTED = 2,
+};
+
+/**
+ * @brief The start of a trace file.
+ */
+typedef struct TraceHeader
+{
+	/* Always "DOMTRACE" */
+	char Magic[8];
+	uint32_t Version;
+
+	/* The size of each record, including the busy time of each worker */
+	uint32_t RecordSize;
+	uint32_t Workers;
+	uint32_t Reserved;
+
+	/* The number of records the file has room for. Once full, the oldest records are overwritten. */
+	uint64_t Capacity;
+
+	/* The number of records ever written. The newest is at index (Written - 1) % Capacity. */
+	std::atomic<uint64_t> Written;
+}TraceHeader;
+
+static_assert(sizeof(TraceHeader) == 40, "The trace file format depends on the size of the header");
+
+/**
+ * @brief Writes a record of every generation of a search to a memory-mapped file, as a ring of fixed-size records.
+ * @details The file is made (or replaced) and sized once, up front, so recording a generation is only a copy into memory: nothing
+ * is flushed, and the operating system writes the file back whenever it likes. Once the ring is full, the oldest records are
+ * overwritten, so a long search keeps its most recent Capacity generations. The count of records written is updated only
+ * after the record itself, so another process can read the file while the search is still running.
+ *
+ * A recorder may be reused by several searches, one after the other, which are all kept in the same file.
+ * Use plotting/trace-to-csv.py to read the file.
+ * @author Brian Schnepp
+ */
+class TraceRecorder
+{
+public:
+	/**
+	 * @brief Creates the trace file.
+	 * @param Path Where to create the file. Anything already there is replaced.
+	 * @param Workers The number of workers of the executor of the search which will be recorded
+	 * @param Capacity How many records the file should have room for. Default is 65536.
+	 */
+	TraceRecorder(const char *Path, uint64_t Workers, uint64_t Capacity = 65536)
+	{
+		this->Workers = Workers;
+		this->Capacity = (Capacity == 0) ? 1 : Capacity;
+		this->RecordSize = sizeof(TraceRecord) + (Workers * sizeof(uint64_t));
+		this->MapSize = sizeof(TraceHeader) + (this->Capacity * this->RecordSize);
+
+		int FD = open(Path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (FD < 0)
+		{
+			return;
+		}
+		if (ftruncate(FD, (off_t)this->MapSize) == 0)
+		{
+			void *Map = mmap(nullptr, this->MapSize, PROT_READ | PROT_WRITE, MAP_SHARED, FD, 0);
+			this->Map = (Map == MAP_FAILED) ? nullptr : static_cast<uint8_t*>(Map);
+		}
+		close(FD);
+
+		if (this->Map != nullptr)
+		{
+			this->Header = new (this->Map) TraceHeader{};
+			std::memcpy(this->Header->Magic, "DOMTRACE", sizeof(this->Header->Magic));
+			this->Header->Version = 1;
+			this->Header->RecordSize = (uint32_t)this->RecordSize;
+			this->Header->Workers = (uint32_t)Workers;
+			this->Header->Capacity = this->Capacity;
+			this->Header->Written.store(0, std::memory_order_release);
+		}
+	}
+
+	~TraceRecorder()
+	{
+		if (this->Map != nullptr)
+		{
+			munmap(this->Map, this->MapSize);
+		}
+	}
+
+	TraceRecorder(const TraceRecorder &Other) = delete;
+	TraceRecorder &operator=(const TraceRecorder &Other) = delete;
+
+	/**
+	 * @brief Whether the file could be created. If not, every record is dropped.
+	 */
+	bool Usable() const
+	{
+		return this->Map != nullptr;
+	}
+
+	/**
+	 * @brief The number of workers each record has the busy time of.
+	 */
+	uint64_t WorkerCount() const
+	{
+		return this->Workers;
+	}
+
+	/**
+	 * @brief Appends a record, overwriting the oldest one if the file is full. Only one thread may append at a time.
+	 * @param Rec What happened in the generation
+	 * @param Busy The busy time of each worker during the generation. Any workers past the first WorkerCount() are left out,
+	 * and any missing are written as 0.
+	 */
+	void Append(const TraceRecord &Rec, const std::vector<uint64_t> &Busy)
+	{
+		if (this->Map == nullptr)
+		{
+			return;
+		}
+
+		const uint64_t Index = this->Header->Written.load(std::memory_order_relaxed);
+		uint8_t *Slot = this->Map + sizeof(TraceHeader) + ((Index % this->Capacity) * this->RecordSize);
+		std::memcpy(Slot, &Rec, sizeof(Rec));
+
+		uint64_t *Times = reinterpret_cast<uint64_t*>(Slot + sizeof(Rec));
+		for (uint64_t TID = 0; TID < this->Workers; TID++)
+		{
+			Times[TID] = (TID < Busy.size()) ? Busy[TID] : 0;
+		}
+		this->Header->Written.store(Index + 1, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Reads back every record still in the file, oldest first, without the busy time of each worker.
+	 * Nobody may be appending at the time.
+	 */
+	std::vector<TraceRecord> Records() const
+	{
+		std::vector<TraceRecord> RetVal;
+		if (this->Map == nullptr)
+		{
+			return RetVal;
+		}
+
+		const uint64_t Written = this->Header->Written.load(std::memory_order_acquire);
+		const uint64_t Count = (Written < this->Capacity) ? Written : this->Capacity;
+		RetVal.resize(Count);
+		for (uint64_t Index = 0; Index < Count; Index++)
+		{
+			const uint64_t Slot = (Written - Count + Index) % this->Capacity;
+			std::memcpy(&RetVal[Index], this->Map + sizeof(TraceHeader) + (Slot * this->RecordSize), sizeof(TraceRecord));
+		}
+		return RetVal;
+	}
+
+	/**
+	 * @brief The busy time of each worker, summed over every record still in the file. Nobody may be appending at the time.
+	 */
+	std::vector<uint64_t> Busy() const
+	{
+		std::vector<uint64_t> RetVal(this->Workers);
+		if (this->Map == nullptr)
+		{
+			return RetVal;
+		}
+
+		const uint64_t Written = this->Header->Written.load(std::memory_order_acquire);
+		const uint64_t Count = (Written < this->Capacity) ? Written : this->Capacity;
+		for (uint64_t Index = 0; Index < Count; Index++)
+		{
+			const uint8_t *Slot = this->Map + sizeof(TraceHeader) + (Index * this->RecordSize);
+			const uint64_t *Times = reinterpret_cast<const uint64_t*>(Slot + sizeof(TraceRecord));
+			for (uint64_t TID = 0; TID < this->Workers; TID++)
+			{
+				RetVal[TID] += Times[TID];
+			}
+		}
+		return RetVal;
+	}
+
+private:
+	uint64_t Workers;
+	uint64_t Capacity;
+	uint64_t RecordSize;
+	uint64_t MapSize;
+
+	uint8_t *Map = nullptr;
+	TraceHeader *Header = nullptr;
+};
+
+}
+
+#endif
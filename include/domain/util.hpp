@@ -1,4 +1,10 @@
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+
 #include "hpfloat.hpp"
+#include "domain/distribution.hpp"
 
 #ifndef DOMAIN_UTIL_HPP_
 #define DOMAIN_UTIL_HPP_
@@ -13,84 +19,190 @@ typedef struct EvalResults
 	dom::hpfloat ComputedValue;
 	dom::hpfloat CorrectValue;
 	uint64_t TotalShadowOps;
+
+	/* How many times P was actually run, which is less than k if the configuration was abandoned early */
+	uint64_t Samples;
 }EvalResults;
 
+namespace impl
+{
+
 /**
- * @brief Implements the Eval function as described in the S3FP paper
+ * @brief Never gives up on a configuration early.
+ */
+struct NeverAbandon
+{
+	bool operator()(const dom::hpfloat &/* Err */, uint64_t /* Samples */) const
+	{
+		return false;
+	}
+};
+
+}
+
+/**
+ * @brief Implements the Eval function as described in the S3FP paper over a batch of configurations at once.
+ * @details The samples of every configuration are interleaved: each round draws and runs one sample of every configuration
+ * still being evaluated. Setup is done once for the whole batch, and memory use does not depend on k (beyond one result
+ * and one set of inputs per configuration).
  * @author Brian Schnepp
  * @see https://formalverification.cs.utah.edu/grt/publications/ppopp14-s3fp.pdf
  * @param P The function to execute, corresponding to the parameter P as described in the paper
- * @param C The configuration of the variables, corresponding to the parameter C as described in the paper
- * @param k The number of times P(C) is run, matching the description of k in the paper
- * @return The highest error seen in any variable over the function P
+ * @param Confs The configurations of the variables, each corresponding to the parameter C as described in the paper
+ * @param k The number of times P(C) is run for each C, matching the description of k in the paper
+ * @param Out Where to write the results, in the same order as Confs. It is resized to fit.
+ * @param Abandon Asked every few samples of each configuration as Abandon(Err, Samples), with the highest error and number of
+ * samples of that configuration so far. If it returns true, the rest of that configuration's samples are skipped, and whatever
+ * was found so far is its result. This may be a temporary.
+ * @param Dist If not nullptr, every error seen in every output is also counted here.
+ * @note P is given the same inputs for every sample of a configuration, refilled with a new sample of every variable in it.
+ * Anything else P leaves in them stays there for the next sample of that configuration, but is never seen by another one.
  */
-template<typename T>
-EvalResults Eval(std::unordered_map<uint64_t, dom::Value<T>> (*P)(std::unordered_map<uint64_t, dom::Value<T>>&), 
-	     const std::unordered_map<uint64_t, bgrt::Variable<T>> &C, uint64_t k)
+template<typename T, typename AbandonFn>
+void EvalBatch(std::unordered_map<uint64_t, dom::Value<T>> (*P)(std::unordered_map<uint64_t, dom::Value<T>>&), 
+	     std::type_identity_t<std::span<const std::unordered_map<uint64_t, bgrt::Variable<T>>>> Confs, uint64_t k,
+	     std::vector<EvalResults> &Out, AbandonFn &&Abandon, ErrorStatistics *Dist = nullptr)
 {
-	uint64_t TotalShadowOps = 0;
-	dom::hpfloat Err = (dom::hpfloat)0.0;
-	dom::hpfloat RelErr = (dom::hpfloat)0.0;
-
-	/* To avoid out-of-control hashmap allocations, run groupings of some smaller k
-	 * if it's particularly large.
-	 */
-	if (k > 500)
-	{
-		/* Split the work in half to avoid crazy memory allocations */
-		EvalResults Left = Eval(P, C, k/2);
-		EvalResults Right = Eval(P, C, (k/2) + (k%2));
-		if (Left.Err > Right.Err)
-		{
-			return Left;
-		}
-		return Right;
-	}
+	/* How many samples are taken between asking whether to give up. */
+	constexpr uint64_t AbandonInterval = 32;
 
 	using Val = dom::Value<T>;
-	using Var = bgrt::Variable<T>;
 	using Array = std::unordered_map<uint64_t, Val>;
-	using Configuration = std::unordered_map<uint64_t, Var>;
 
-	Array SubmitVals;
+	const uint64_t Count = Confs.size();
+	Out.resize(Count);
 
-	std::vector<Array> SampleConfs(k);
-
-	/* Call F on this configuration K times (Section 3.1) */
-	for (const auto &Pair : C)
+	/* Which configurations are still being sampled, and the value with the highest error for each */
+	std::vector<uint8_t> Active(Count, 1);
+	std::vector<Val> Results(Count);
+	for (uint64_t Index = 0; Index < Count; Index++)
 	{
-		/* Sample a point within the given domain */
-		uint64_t tileK = 0;
-		for (; tileK < SampleConfs.capacity(); tileK++)
-		{
-			SampleConfs[tileK][Pair.first] = Pair.second.Sample();
-		}
+		Out[Index].Err = 0.0;
+		Out[Index].RelErr = 0.0;
+		Out[Index].TotalShadowOps = 0;
+		Out[Index].Samples = 0;
 	}
 
-	dom::Value<T> Result;
-
-	/* Call F on this configuration K times (Section 3.1)*/
-	for (uint64_t iK = 0; iK < k; iK++)
+	/* Samples are generated, run, and reduced one at a time, each through the same set of inputs as the configuration's
+	 * last one. This keeps memory use the same no matter how big k is, and keeps configurations from seeing each other's.
+	 */
+	std::vector<Array> SubmitVals(Count);
+	for (uint64_t Index = 0; Index < Count; Index++)
 	{
-		const Array &Next = P(SampleConfs[iK]);
+		SubmitVals[Index].reserve(Confs[Index].size());
+	}
 
-		for (auto &Pair : Next)
+	/* Call F on each configuration K times (Section 3.1)*/
+	uint64_t Remaining = Count;
+	for (uint64_t iK = 0; iK < k && Remaining != 0; iK++)
+	{
+		for (uint64_t Index = 0; Index < Count; Index++)
 		{
-			hpfloat Error = Pair.second.Error();
-			hpfloat RelError = Pair.second.RelError();
+			if (!Active[Index])
+			{
+				continue;
+			}
+
+			const auto &C = Confs[Index];
+			EvalResults &Res = Out[Index];
+			Array &Inputs = SubmitVals[Index];
 
-			if (Error > Err)
+			/* Sample a point within the given domain, overwriting the last one */
+			for (const auto &Pair : C)
 			{
-				Err = Error;
-				RelErr = RelError;
-				Result = Pair.second;
+				Inputs[Pair.first] = Pair.second.Sample();
 			}
 
-			TotalShadowOps += Pair.second.Ops();
+			Res.Samples++;
+			const Array &Next = P(Inputs);
+
+			for (auto &Pair : Next)
+			{
+				hpfloat Error = Pair.second.Error();
+				if (Dist != nullptr)
+				{
+					Dist->Record(Pair.first, Error);
+				}
+
+				if (Error > Res.Err)
+				{
+					Res.Err = Error;
+					Res.RelErr = Pair.second.RelError();
+					Results[Index] = Pair.second;
+				}
+
+				Res.TotalShadowOps += Pair.second.Ops();
+			}
+
+			if ((iK + 1) % AbandonInterval == 0 && Abandon(Res.Err, iK + 1))
+			{
+				Active[Index] = 0;
+				Remaining--;
+			}
 		}
 	}
 
-	return {Err, RelErr, Result.Val(), Result.SVal(), TotalShadowOps};	
+	for (uint64_t Index = 0; Index < Count; Index++)
+	{
+		Out[Index].ComputedValue = Results[Index].Val();
+		Out[Index].CorrectValue = Results[Index].SVal();
+	}
+}
+
+/**
+ * @brief Implements the Eval function as described in the S3FP paper over a batch of configurations at once.
+ * @author Brian Schnepp
+ * @see https://formalverification.cs.utah.edu/grt/publications/ppopp14-s3fp.pdf
+ * @param P The function to execute, corresponding to the parameter P as described in the paper
+ * @param Confs The configurations of the variables, each corresponding to the parameter C as described in the paper
+ * @param k The number of times P(C) is run for each C, matching the description of k in the paper
+ * @return The highest error seen in any variable over the function P, for each configuration in order
+ */
+template<typename T>
+std::vector<EvalResults> EvalBatch(std::unordered_map<uint64_t, dom::Value<T>> (*P)(std::unordered_map<uint64_t, dom::Value<T>>&), 
+	     const std::vector<std::unordered_map<uint64_t, bgrt::Variable<T>>> &Confs, uint64_t k)
+{
+	std::vector<EvalResults> RetVal;
+	EvalBatch(P, Confs, k, RetVal, impl::NeverAbandon{});
+	return RetVal;
+}
+
+/**
+ * @brief Implements the Eval function as described in the S3FP paper, with the option of giving up on C early.
+ * @author Brian Schnepp
+ * @see https://formalverification.cs.utah.edu/grt/publications/ppopp14-s3fp.pdf
+ * @param P The function to execute, corresponding to the parameter P as described in the paper
+ * @param C The configuration of the variables, corresponding to the parameter C as described in the paper
+ * @param k The number of times P(C) is run, matching the description of k in the paper
+ * @param Abandon Asked every few samples as Abandon(Err, Samples), with the highest error and number of samples so far.
+ * If it returns true, the remaining samples are skipped, and whatever was found so far is returned. This may be a temporary.
+ * @param Dist If not nullptr, every error seen in every output is also counted here.
+ * @note P is given the same inputs every time, refilled with a new sample of every variable in C. Anything else P leaves in them stays there.
+ * @return The highest error seen in any variable over the function P
+ */
+template<typename T, typename AbandonFn>
+EvalResults Eval(std::unordered_map<uint64_t, dom::Value<T>> (*P)(std::unordered_map<uint64_t, dom::Value<T>>&), 
+	     const std::unordered_map<uint64_t, bgrt::Variable<T>> &C, uint64_t k, AbandonFn &&Abandon, ErrorStatistics *Dist = nullptr)
+{
+	std::vector<EvalResults> RetVal;
+	EvalBatch(P, std::span(&C, 1), k, RetVal, Abandon, Dist);
+	return RetVal[0];
+}
+
+/**
+ * @brief Implements the Eval function as described in the S3FP paper
+ * @author Brian Schnepp
+ * @see https://formalverification.cs.utah.edu/grt/publications/ppopp14-s3fp.pdf
+ * @param P The function to execute, corresponding to the parameter P as described in the paper
+ * @param C The configuration of the variables, corresponding to the parameter C as described in the paper
+ * @param k The number of times P(C) is run, matching the description of k in the paper
+ * @return The highest error seen in any variable over the function P
+ */
+template<typename T>
+EvalResults Eval(std::unordered_map<uint64_t, dom::Value<T>> (*P)(std::unordered_map<uint64_t, dom::Value<T>>&), 
+	     const std::unordered_map<uint64_t, bgrt::Variable<T>> &C, uint64_t k)
+{
+	return Eval(P, C, k, impl::NeverAbandon{});
 }
 
 }
@@ -0,0 +1,82 @@
+#include <vector>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+#ifndef DOMAIN_IMPL_AFFINITY_HPP_
+#define DOMAIN_IMPL_AFFINITY_HPP_
+
+/**
+ * @file include/impl/affinity.hpp
+ * @brief Helpers for placing worker threads on fixed CPUs
+ */
+
+namespace dom::impl
+{
+
+/**
+ * @brief Lists the logical CPUs this process is allowed to run on, in ascending order.
+ * @details On Linux, this respects any restriction placed by taskset, cgroups, or a batch scheduler.
+ * Elsewhere, every CPU reported by the standard library is assumed to be available.
+ * @author Brian Schnepp
+ * @return The list of usable CPU indices. Never empty.
+ */
+inline std::vector<uint64_t> AllowedCPUs()
+{
+	std::vector<uint64_t> RetVal;
+#if defined(__linux__)
+	cpu_set_t Set;
+	CPU_ZERO(&Set);
+	if (sched_getaffinity(0, sizeof(Set), &Set) == 0)
+	{
+		for (uint64_t CPU = 0; CPU < CPU_SETSIZE; CPU++)
+		{
+			if (CPU_ISSET(CPU, &Set))
+			{
+				RetVal.push_back(CPU);
+			}
+		}
+	}
+#endif
+	if (RetVal.empty())
+	{
+		uint64_t Count = std::thread::hardware_concurrency();
+		for (uint64_t CPU = 0; CPU < ((Count == 0) ? 1 : Count); CPU++)
+		{
+			RetVal.push_back(CPU);
+		}
+	}
+	return RetVal;
+}
+
+/**
+ * @brief Pins the calling thread to the logical CPU assigned to a given worker.
+ * @details Workers are spread over the allowed CPUs in order, so consecutive TIDs land on
+ * consecutive cores (and therefore the same socket, for the usual Linux CPU numbering).
+ * Once pinned, anything the worker allocates and touches first is placed on its local NUMA node.
+ * @author Brian Schnepp
+ * @param TID The ID of the worker being placed
+ * @param CPUs The list of CPUs available, as from AllowedCPUs()
+ * @return True if the thread was pinned, false if the platform does not support it.
+ */
+inline bool PinWorker(uint64_t TID, const std::vector<uint64_t> &CPUs)
+{
+#if defined(__linux__)
+	cpu_set_t Set;
+	CPU_ZERO(&Set);
+	CPU_SET(CPUs[TID % CPUs.size()], &Set);
+	return pthread_setaffinity_np(pthread_self(), sizeof(Set), &Set) == 0;
+#else
+	(void)TID;
+	(void)CPUs;
+	return false;
+#endif
+}
+
+}
+
+#endif
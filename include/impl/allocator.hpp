@@ -0,0 +1,102 @@
+#include <new>
+#include <cstddef>
+#include <cstdlib>
+
+#include <gmp.h>
+
+#ifndef DOMAIN_IMPL_ALLOCATOR_HPP_
+#define DOMAIN_IMPL_ALLOCATOR_HPP_
+
+/**
+ * @file include/impl/allocator.hpp
+ * @brief Allocation functions which count every allocation, for replacing the global ones and GMP's
+ */
+
+namespace dom::impl
+{
+
+/**
+ * @brief Allocates through malloc, and tells Counter about every allocation.
+ * @details Counter must have static functions Heap() and MPFR(), which are called for every allocation made through
+ * operator new and through GMP (and so MPFR), respectively. A reallocation counts as an allocation, since it may well be one.
+ *
+ * Install() sends GMP's allocations here, and must be called before any hpfloat is created. To also send operator new
+ * here, expand DOMAIN_REPLACE_GLOBAL_NEW(Counter) at namespace scope in exactly one file of the program.
+ * @author Brian Schnepp
+ */
+template<typename Counter>
+struct CountingAllocator
+{
+	static void *Allocate(std::size_t Size)
+	{
+		Counter::Heap();
+		void *Ptr = std::malloc((Size == 0) ? 1 : Size);
+		if (Ptr == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		return Ptr;
+	}
+
+	static void *AllocateAligned(std::size_t Size, std::align_val_t Align)
+	{
+		Counter::Heap();
+		const std::size_t Alignment = (std::size_t)Align;
+		void *Ptr = std::aligned_alloc(Alignment, (((Size == 0) ? 1 : Size) + Alignment - 1) & ~(Alignment - 1));
+		if (Ptr == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		return Ptr;
+	}
+
+	/* GMP's allocator may not throw, and aborts by itself if it runs out of memory. */
+	static void *GMPAllocate(std::size_t Size)
+	{
+		Counter::MPFR();
+		return std::malloc(Size);
+	}
+
+	static void *GMPReallocate(void *Ptr, std::size_t /* OldSize */, std::size_t NewSize)
+	{
+		Counter::MPFR();
+		return std::realloc(Ptr, NewSize);
+	}
+
+	static void GMPFree(void *Ptr, std::size_t /* Size */)
+	{
+		std::free(Ptr);
+	}
+
+	static void Install()
+	{
+		mp_set_memory_functions(GMPAllocate, GMPReallocate, GMPFree);
+	}
+};
+
+}
+
+/**
+ * @brief Replaces every global operator new and delete with ones which count through dom::impl::CountingAllocator<Counter>.
+ */
+#define DOMAIN_REPLACE_GLOBAL_NEW(Counter) \
+	void *operator new(std::size_t Size) { return dom::impl::CountingAllocator<Counter>::Allocate(Size); } \
+	void *operator new[](std::size_t Size) { return dom::impl::CountingAllocator<Counter>::Allocate(Size); } \
+	void *operator new(std::size_t Size, std::align_val_t Align) \
+	{ \
+		return dom::impl::CountingAllocator<Counter>::AllocateAligned(Size, Align); \
+	} \
+	void *operator new[](std::size_t Size, std::align_val_t Align) \
+	{ \
+		return dom::impl::CountingAllocator<Counter>::AllocateAligned(Size, Align); \
+	} \
+	void operator delete(void *Ptr) noexcept { std::free(Ptr); } \
+	void operator delete[](void *Ptr) noexcept { std::free(Ptr); } \
+	void operator delete(void *Ptr, std::size_t /* Size */) noexcept { std::free(Ptr); } \
+	void operator delete[](void *Ptr, std::size_t /* Size */) noexcept { std::free(Ptr); } \
+	void operator delete(void *Ptr, std::align_val_t /* Align */) noexcept { std::free(Ptr); } \
+	void operator delete[](void *Ptr, std::align_val_t /* Align */) noexcept { std::free(Ptr); } \
+	void operator delete(void *Ptr, std::size_t /* Size */, std::align_val_t /* Align */) noexcept { std::free(Ptr); } \
+	void operator delete[](void *Ptr, std::size_t /* Size */, std::align_val_t /* Align */) noexcept { std::free(Ptr); }
+
+#endif
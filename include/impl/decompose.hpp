@@ -0,0 +1,146 @@
+#include <deque>
+#include <vector>
+#include <iterator>
+#include <cstdint>
+#include <unordered_map>
+
+#include <value.hpp>
+#include <hpfloat.hpp>
+#include <bgrt/bgrt.hpp>
+
+#ifndef DOMAIN_IMPL_DECOMPOSE_HPP_
+#define DOMAIN_IMPL_DECOMPOSE_HPP_
+
+/**
+ * @file include/impl/decompose.hpp
+ * @brief Splitting a configuration into disjoint pieces, so that each can be searched on its own
+ */
+
+namespace dom::impl
+{
+
+/**
+ * @brief Splits a configuration in two, along whichever of its variables has the widest range.
+ * @details Variables whose range is empty are never split.
+ * @author Brian Schnepp
+ * @param Box The configuration to split, which is left as the lower half
+ * @param Upper Set to the upper half
+ * @param Key Set to the key of the variable which was split
+ * @return Whether there was any variable to split. If not, Box is left as it was.
+ */
+template<typename T>
+bool Bisect(std::unordered_map<uint64_t, bgrt::Variable<T>> &Box, std::unordered_map<uint64_t, bgrt::Variable<T>> &Upper,
+	uint64_t &Key)
+{
+	/* Find the widest variable of this box */
+	auto Widest = Box.end();
+	dom::hpfloat Width = 0.0;
+	for (auto It = Box.begin(); It != Box.end(); ++It)
+	{
+		dom::hpfloat Size = It->second.Max().SVal() - It->second.Min().SVal();
+		if (Size > Width)
+		{
+			Width = Size;
+			Widest = It;
+		}
+	}
+
+	if (Widest == Box.end())
+	{
+		return false;
+	}
+
+	dom::hpfloat MidP = Widest->second.Min().SVal();
+	MidP += Width / 2.0;
+
+	Key = Widest->first;
+	Upper = Box;
+	Upper[Key] = bgrt::Variable<T>(dom::Value<T>(MidP), Widest->second.Max());
+	Widest->second = bgrt::Variable<T>(Widest->second.Min(), dom::Value<T>(MidP));
+	return true;
+}
+
+/**
+ * @brief Splits the rest of a search in two, keeping the half it is currently in.
+ * @details Base is bisected along its widest variable (see Bisect), and keeps whichever half the middle of Conf is in. Conf
+ * is cut down to that half too, or goes back to it if what is left of Conf would be filtered out.
+ * @author Brian Schnepp
+ * @param Conf The configuration being searched
+ * @param Base The configuration the search restarts from, which Conf is within
+ * @param Accept The filtering policy of the search. Nothing is split off unless both halves pass it, since whoever is given
+ * a half would otherwise have nothing to search, and soon ask again.
+ * @param Given Set to the half which is given away
+ * @return Whether anything was split off. If not, Conf and Base are left as they were.
+ */
+template<typename T, typename FilterFn>
+bool Halve(std::unordered_map<uint64_t, bgrt::Variable<T>> &Conf, std::unordered_map<uint64_t, bgrt::Variable<T>> &Base,
+	const FilterFn &Accept, std::unordered_map<uint64_t, bgrt::Variable<T>> &Given)
+{
+	using Configuration = std::unordered_map<uint64_t, bgrt::Variable<T>>;
+
+	Configuration Lower = Base;
+	Configuration Upper;
+	uint64_t Key = 0;
+	if (!Bisect(Lower, Upper, Key) || !Accept(Lower) || !Accept(Upper))
+	{
+		return false;
+	}
+
+	/* Keep whichever half holds the middle of the variable which was split. */
+	const dom::Value<T> Mid = Lower[Key].Max();
+	const bgrt::Variable<T> &Var = Conf[Key];
+	dom::hpfloat Center = Var.Min().SVal();
+	Center += (Var.Max().SVal() - Var.Min().SVal()) / 2.0;
+	const bool KeepLower = Center < Mid.SVal();
+	Base = KeepLower ? std::move(Lower) : std::move(Upper);
+	Given = KeepLower ? std::move(Upper) : std::move(Lower);
+
+	/* Only search what is left of Conf in the half which is kept. */
+	Configuration Clipped = Conf;
+	Clipped[Key] = KeepLower ? bgrt::Variable<T>(Var.Min(), (Var.Max().SVal() < Mid.SVal()) ? Var.Max() : Mid)
+		: bgrt::Variable<T>((Var.Min().SVal() > Mid.SVal()) ? Var.Min() : Mid, Var.Max());
+	Conf = Accept(Clipped) ? std::move(Clipped) : Base;
+	return true;
+}
+
+/**
+ * @brief Splits a configuration into disjoint sub-boxes, which together cover all of it.
+ * @details Boxes are bisected (see Bisect) in the order they were made, so that no box is ever more than twice the volume
+ * of another, and boxes stay as close to square as they can.
+ * @author Brian Schnepp
+ * @param Conf The configuration to split
+ * @param Count How many boxes to split it into
+ * @return Count boxes, or fewer if every variable ran out of room to split
+ */
+template<typename T>
+std::vector<std::unordered_map<uint64_t, bgrt::Variable<T>>> Decompose(const std::unordered_map<uint64_t, bgrt::Variable<T>> &Conf,
+	uint64_t Count)
+{
+	using Configuration = std::unordered_map<uint64_t, bgrt::Variable<T>>;
+
+	std::deque<Configuration> Boxes{Conf};
+	std::vector<Configuration> Done;
+	while (!Boxes.empty() && Boxes.size() + Done.size() < Count)
+	{
+		Configuration Box = std::move(Boxes.front());
+		Boxes.pop_front();
+
+		/* Nothing left to split: keep the box as it is. */
+		Configuration Upper;
+		uint64_t Key = 0;
+		if (!Bisect(Box, Upper, Key))
+		{
+			Done.push_back(std::move(Box));
+			continue;
+		}
+		Boxes.push_back(std::move(Box));
+		Boxes.push_back(std::move(Upper));
+	}
+
+	Done.insert(Done.end(), std::make_move_iterator(Boxes.begin()), std::make_move_iterator(Boxes.end()));
+	return Done;
+}
+
+}
+
+#endif
@@ -0,0 +1,171 @@
+#include <atomic>
+#include <cstdint>
+
+#include <hpfloat.hpp>
+
+#ifndef DOMAIN_IMPL_INCUMBENT_HPP_
+#define DOMAIN_IMPL_INCUMBENT_HPP_
+
+/**
+ * @file include/impl/incumbent.hpp
+ * @brief The best error found by any worker so far, shared between them as it is found
+ */
+
+namespace dom::impl
+{
+
+/**
+ * @brief The full description of the current incumbent, as read from an Incumbent.
+ */
+typedef struct IncumbentRecord
+{
+	/* The error of the incumbent, rounded to doubles */
+	double Err;
+	double RelErr;
+
+	/* Which worker found it, and in which generation */
+	uint64_t TID;
+	uint64_t Generation;
+}IncumbentRecord;
+
+/**
+ * @brief A lock-free incumbent, which every worker may offer its results to as soon as they are computed.
+ * @details The bound is a single relaxed atomic, so workers can compare against it in the hot loop for the cost of a load.
+ * It holds the error rounded toward zero, so it never claims more than what was actually found, and is safe to prune with.
+ * The rest of the record is kept behind a sequence lock, where the (rare) writers serialize on the sequence number,
+ * and readers retry if a write happened while they were reading.
+ * @author Brian Schnepp
+ */
+class Incumbent
+{
+public:
+	Incumbent() = default;
+	~Incumbent() = default;
+
+	Incumbent(const Incumbent &Other) = delete;
+	Incumbent &operator=(const Incumbent &Other) = delete;
+
+	static_assert(std::atomic<double>::is_always_lock_free);
+
+	/**
+	 * @brief Forgets the current incumbent. This must not run concurrently with Offer().
+	 * @param Generation The generation any following offers are made in
+	 */
+	void Reset(uint64_t Generation)
+	{
+		this->Gen = Generation;
+		this->BoundVal.store(0.0, std::memory_order_relaxed);
+		this->Write(IncumbentRecord{0.0, 0.0, 0, Generation});
+	}
+
+	/**
+	 * @brief The error of the incumbent, as a lower bound. Errors at or below this cannot replace it.
+	 */
+	double Bound() const
+	{
+		return this->BoundVal.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Offers a new result, which replaces the incumbent if its error is higher.
+	 * @param Err The absolute error of the result
+	 * @param RelErr The relative error of the result
+	 * @param TID The worker offering the result
+	 * @return Whether the result became the incumbent
+	 */
+	bool Offer(const dom::hpfloat &Err, const dom::hpfloat &RelErr, uint64_t TID)
+	{
+		double Down = mpfr_get_d(Err.mpfr_srcptr(), MPFR_RNDZ);
+
+		/* The common case: something better was already found. */
+		if (Down <= this->BoundVal.load(std::memory_order_relaxed))
+		{
+			return false;
+		}
+
+		uint64_t Seq = this->Lock();
+		bool Better = Down > this->BoundVal.load(std::memory_order_relaxed);
+		if (Better)
+		{
+			this->Store(IncumbentRecord{Down, mpfr_get_d(RelErr.mpfr_srcptr(), MPFR_RNDN), TID, this->Gen});
+			this->BoundVal.store(Down, std::memory_order_relaxed);
+		}
+		this->Sequence.store(Seq + 2, std::memory_order_release);
+		return Better;
+	}
+
+	/**
+	 * @brief Reads the full record of the incumbent. This may be called from any thread at any time.
+	 */
+	IncumbentRecord Read() const
+	{
+		while (true)
+		{
+			uint64_t Before = this->Sequence.load(std::memory_order_acquire);
+			if (Before & 1)
+			{
+				continue;
+			}
+
+			IncumbentRecord RetVal;
+			RetVal.Err = this->Err.load(std::memory_order_relaxed);
+			RetVal.RelErr = this->RelErr.load(std::memory_order_relaxed);
+			RetVal.TID = this->TID.load(std::memory_order_relaxed);
+			RetVal.Generation = this->Generation.load(std::memory_order_relaxed);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (this->Sequence.load(std::memory_order_relaxed) == Before)
+			{
+				return RetVal;
+			}
+		}
+	}
+
+private:
+	/**
+	 * @brief Takes the write side of the sequence lock, returning the (even) sequence number from before.
+	 */
+	uint64_t Lock()
+	{
+		uint64_t Seq = this->Sequence.load(std::memory_order_relaxed);
+		while ((Seq & 1) || !this->Sequence.compare_exchange_weak(Seq, Seq + 1, std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			Seq = this->Sequence.load(std::memory_order_relaxed);
+		}
+
+		/* Readers must not see any of the new record before they see the sequence number go odd. */
+		std::atomic_thread_fence(std::memory_order_release);
+		return Seq;
+	}
+
+	void Store(const IncumbentRecord &Rec)
+	{
+		this->Err.store(Rec.Err, std::memory_order_relaxed);
+		this->RelErr.store(Rec.RelErr, std::memory_order_relaxed);
+		this->TID.store(Rec.TID, std::memory_order_relaxed);
+		this->Generation.store(Rec.Generation, std::memory_order_relaxed);
+	}
+
+	void Write(const IncumbentRecord &Rec)
+	{
+		uint64_t Seq = this->Lock();
+		this->Store(Rec);
+		this->Sequence.store(Seq + 2, std::memory_order_release);
+	}
+
+	/* The bound is read by every worker after every Eval, so keep it away from anything else that's written. */
+	alignas(64) std::atomic<double> BoundVal = 0.0;
+
+	alignas(64) std::atomic_uint64_t Sequence = 0;
+	std::atomic<double> Err = 0.0;
+	std::atomic<double> RelErr = 0.0;
+	std::atomic_uint64_t TID = 0;
+	std::atomic_uint64_t Generation = 0;
+
+	/* Only written by Reset(), while no worker is running. */
+	uint64_t Gen = 0;
+};
+
+}
+
+#endif
@@ -11,29 +11,41 @@
 namespace dom::impl
 {
 
+/**
+ * @brief Makes one worker's share of the next generation, keeping only what OkayFn accepts.
+ * @details Each worker gets Iterations / NumThreads splits of the BGRT state, and the last one also gets the rest.
+ * This only reads BGRT, so every worker may make its own slice at the same time.
+ * @param Out Where to append the accepted configurations
+ */
+template<typename T, typename F>
+void PartitionSlice(uint64_t TID, uint64_t NumThreads, const uint64_t Iterations, const bgrt::BGRTState<T> &BGRT, F OkayFn,
+	std::vector<std::unordered_map<uint64_t, bgrt::Variable<T>>> &Out)
+{
+	uint64_t MyIterations = Iterations / NumThreads;
+	if (TID + 1 == NumThreads)
+	{
+		/* Get the rest of the values */
+		MyIterations += Iterations % NumThreads;
+	}
+
+	std::vector<std::unordered_map < uint64_t, bgrt::Variable<T> > > NextConfs = BGRT.NextGen(MyIterations);
+	for (uint64_t TotalIndex = 0; TotalIndex < NextConfs.size(); TotalIndex++)
+	{
+		if (OkayFn(NextConfs[TotalIndex]))
+		{
+			Out.push_back(std::move(NextConfs[TotalIndex]));
+		}
+	}
+}
+
 template<typename T, typename F>
 std::vector < std::vector < std::unordered_map < uint64_t, bgrt::Variable<T> > > >  
 PartitionConfigs(uint64_t NumThreads, const uint64_t Iterations, bgrt::BGRTState<T> &BGRT, F OkayFn)
 {
 	std::vector < std::vector < std::unordered_map < uint64_t, bgrt::Variable<T> > > > PartNextConfs(NumThreads);
-
-	uint64_t MyIterations = Iterations / NumThreads;
 	for (uint64_t TID = 0; TID < NumThreads; TID++)
 	{
-		if (TID + 1 == NumThreads)
-		{
-			/* Get the rest of the values */
-			MyIterations += Iterations % NumThreads;
-		}
-		
-		const std::vector<std::unordered_map < uint64_t, bgrt::Variable<T> > > NextConfs = BGRT.NextGen(MyIterations);
-		for (uint64_t TotalIndex = 0; TotalIndex < NextConfs.size(); TotalIndex++)
-		{
-			if (OkayFn(NextConfs[TotalIndex]))
-			{
-				PartNextConfs[TID].push_back(NextConfs[TotalIndex]);
-			}
-		}
+		PartitionSlice<T>(TID, NumThreads, Iterations, BGRT, OkayFn, PartNextConfs[TID]);
 	}
 	return PartNextConfs;
 }
@@ -41,4 +53,4 @@ PartitionConfigs(uint64_t NumThreads, const uint64_t Iterations, bgrt::BGRTState
 
 }
 
-#endif
\ No newline at end of file
+#endif
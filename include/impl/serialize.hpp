@@ -0,0 +1,351 @@
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+#include <value.hpp>
+#include <hpfloat.hpp>
+#include <bgrt/bgrt.hpp>
+
+#include "domain/util.hpp"
+#include "domain/distribution.hpp"
+
+#ifndef DOMAIN_IMPL_SERIALIZE_HPP_
+#define DOMAIN_IMPL_SERIALIZE_HPP_
+
+/**
+ * @file include/impl/serialize.hpp
+ * @brief A compact, lossless binary encoding of high-precision results and configurations, for sending them elsewhere
+ */
+
+namespace dom::impl
+{
+
+/**
+ * @brief Appends values to a buffer of bytes, without losing any precision.
+ * @details An hpfloat is written as its precision, a byte holding its kind (zero, regular, infinite, or NaN) and sign,
+ * and, if it is regular, its exponent and every limb of its significand. Everything is in the byte order of the host,
+ * so the reader must run on the same kind of machine, with the same MPFR limb size.
+ * @author Brian Schnepp
+ */
+class Serializer
+{
+public:
+	void Write(uint64_t Val)
+	{
+		this->Raw(&Val, sizeof(Val));
+	}
+
+	void Write(const dom::hpfloat &Val)
+	{
+		mpfr_srcptr Src = Val.mpfr_srcptr();
+		int64_t Prec = mpfr_get_prec(Src);
+		this->Raw(&Prec, sizeof(Prec));
+
+		uint8_t Kind = mpfr_regular_p(Src) ? 1 : (mpfr_zero_p(Src) ? 0 : (mpfr_inf_p(Src) ? 2 : 3));
+		uint8_t Header = (uint8_t)(Kind | (mpfr_signbit(Src) ? 0x80 : 0x00));
+		this->Raw(&Header, sizeof(Header));
+		if (Kind != 1)
+		{
+			return;
+		}
+
+		int64_t Exp = mpfr_get_exp(Src);
+		this->Raw(&Exp, sizeof(Exp));
+		this->Raw(mpfr_custom_get_significand(const_cast<mpfr_ptr>(Src)), mpfr_custom_get_size(Prec));
+	}
+
+	void Write(const EvalResults &Val)
+	{
+		this->Write(Val.Err);
+		this->Write(Val.RelErr);
+		this->Write(Val.ComputedValue);
+		this->Write(Val.CorrectValue);
+		this->Write(Val.TotalShadowOps);
+		this->Write(Val.Samples);
+	}
+
+	template<typename T>
+	void Write(const dom::Value<T> &Val)
+	{
+		T Orig = Val.Val();
+		this->Raw(&Orig, sizeof(Orig));
+		this->Write(Val.SVal());
+	}
+
+	template<typename T>
+	void Write(const std::unordered_map<uint64_t, bgrt::Variable<T>> &Conf)
+	{
+		this->Write((uint64_t)Conf.size());
+		for (const auto &Pair : Conf)
+		{
+			this->Write(Pair.first);
+			this->Write(Pair.second.Min());
+			this->Write(Pair.second.Max());
+		}
+	}
+
+	/**
+	 * @brief Writes a collector of errors, leaving out every empty bin.
+	 */
+	void Write(const ErrorStatistics &Val)
+	{
+		this->Write(Val.Total);
+		this->Write(Val.Zeros);
+		this->Write(Val.NonFinite);
+		this->Raw(&Val.Sum, sizeof(Val.Sum));
+		this->Raw(&Val.Largest, sizeof(Val.Largest));
+
+		uint64_t Used = 0;
+		for (uint64_t Count : Val.Bins)
+		{
+			Used += (Count != 0) ? 1 : 0;
+		}
+		this->Write(Used);
+		for (uint64_t Index = 0; Index < Val.Bins.size(); Index++)
+		{
+			if (Val.Bins[Index] != 0)
+			{
+				this->Write(Index);
+				this->Write(Val.Bins[Index]);
+			}
+		}
+
+		this->Write((uint64_t)Val.OutputMax.size());
+		for (const auto &Pair : Val.OutputMax)
+		{
+			this->Write(Pair.first);
+			this->Raw(&Pair.second, sizeof(Pair.second));
+		}
+	}
+
+	/**
+	 * @brief Everything written so far.
+	 */
+	const std::vector<uint8_t> &Bytes() const
+	{
+		return this->Buffer;
+	}
+
+	/**
+	 * @brief Forgets everything written so far, keeping the memory for reuse.
+	 */
+	void Clear()
+	{
+		this->Buffer.clear();
+	}
+
+private:
+	void Raw(const void *Src, uint64_t Size)
+	{
+		const uint8_t *Bytes = static_cast<const uint8_t*>(Src);
+		this->Buffer.insert(this->Buffer.end(), Bytes, Bytes + Size);
+	}
+
+	std::vector<uint8_t> Buffer;
+};
+
+/**
+ * @brief Reads values back out of a buffer written by a Serializer, in the same order they were written.
+ * @details Every Read returns false if the buffer ends too soon or holds something which is not valid, in which case
+ * the value read into is left in an unspecified (but valid) state, and every later Read also fails.
+ * @author Brian Schnepp
+ */
+class Deserializer
+{
+public:
+	Deserializer(const uint8_t *Data, uint64_t Size) : Data(Data), Size(Size)
+	{
+	}
+
+	explicit Deserializer(const std::vector<uint8_t> &Buffer) : Deserializer(Buffer.data(), Buffer.size())
+	{
+	}
+
+	bool Read(uint64_t &Val)
+	{
+		return this->Raw(&Val, sizeof(Val));
+	}
+
+	bool Read(dom::hpfloat &Val)
+	{
+		int64_t Prec = 0;
+		uint8_t Header = 0;
+		if (!this->Raw(&Prec, sizeof(Prec)) || !this->Raw(&Header, sizeof(Header)))
+		{
+			return false;
+		}
+		if (Prec < MPFR_PREC_MIN || Prec > MPFR_PREC_MAX)
+		{
+			return this->Fail();
+		}
+
+		mpfr_ptr Dst = Val.mpfr_ptr();
+		mpfr_set_prec(Dst, (mpfr_prec_t)Prec);
+		const uint8_t Kind = Header & 0x7F;
+		const int Sign = (Header & 0x80) ? -1 : 1;
+		switch (Kind)
+		{
+		case 0:
+			mpfr_set_zero(Dst, Sign);
+			return true;
+
+		case 2:
+			mpfr_set_inf(Dst, Sign);
+			return true;
+
+		case 3:
+			mpfr_set_nan(Dst);
+			return true;
+
+		case 1:
+			break;
+
+		default:
+			return this->Fail();
+		}
+
+		int64_t Exp = 0;
+		if (!this->Raw(&Exp, sizeof(Exp)))
+		{
+			return false;
+		}
+
+		/* Make the destination a regular number first, so its significand and exponent can be replaced. */
+		mpfr_set_ui(Dst, 1, MPFR_RNDN);
+		if (!this->Raw(mpfr_custom_get_significand(Dst), mpfr_custom_get_size(Prec)))
+		{
+			return false;
+		}
+		if (mpfr_set_exp(Dst, (mpfr_exp_t)Exp) != 0)
+		{
+			return this->Fail();
+		}
+		mpfr_setsign(Dst, Dst, Sign < 0, MPFR_RNDN);
+		return true;
+	}
+
+	bool Read(EvalResults &Val)
+	{
+		return this->Read(Val.Err) && this->Read(Val.RelErr) && this->Read(Val.ComputedValue) && this->Read(Val.CorrectValue)
+			&& this->Read(Val.TotalShadowOps) && this->Read(Val.Samples);
+	}
+
+	template<typename T>
+	bool Read(dom::Value<T> &Val)
+	{
+		T Orig;
+		dom::hpfloat Shadow;
+		if (!this->Raw(&Orig, sizeof(Orig)) || !this->Read(Shadow))
+		{
+			return false;
+		}
+		Val = dom::Value<T>(Orig, Shadow);
+		return true;
+	}
+
+	template<typename T>
+	bool Read(std::unordered_map<uint64_t, bgrt::Variable<T>> &Conf)
+	{
+		uint64_t Count = 0;
+		if (!this->Read(Count))
+		{
+			return false;
+		}
+
+		Conf.clear();
+		for (uint64_t Index = 0; Index < Count; Index++)
+		{
+			uint64_t Key = 0;
+			dom::Value<T> Min;
+			dom::Value<T> Max;
+			if (!this->Read(Key) || !this->Read(Min) || !this->Read(Max))
+			{
+				return false;
+			}
+			Conf[Key] = bgrt::Variable<T>(Min, Max);
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Reads a collector of errors, replacing whatever it had counted before.
+	 */
+	bool Read(ErrorStatistics &Val)
+	{
+		Val.Clear();
+		uint64_t Used = 0;
+		if (!this->Read(Val.Total) || !this->Read(Val.Zeros) || !this->Read(Val.NonFinite)
+			|| !this->Raw(&Val.Sum, sizeof(Val.Sum)) || !this->Raw(&Val.Largest, sizeof(Val.Largest)) || !this->Read(Used))
+		{
+			return false;
+		}
+
+		for (uint64_t Bin = 0; Bin < Used; Bin++)
+		{
+			uint64_t Index = 0;
+			uint64_t Count = 0;
+			if (!this->Read(Index) || !this->Read(Count))
+			{
+				return false;
+			}
+			if (Index >= Val.Bins.size())
+			{
+				return this->Fail();
+			}
+			Val.Bins[Index] = Count;
+		}
+
+		uint64_t Outputs = 0;
+		if (!this->Read(Outputs))
+		{
+			return false;
+		}
+		for (uint64_t Output = 0; Output < Outputs; Output++)
+		{
+			uint64_t Key = 0;
+			double Max = 0.0;
+			if (!this->Read(Key) || !this->Raw(&Max, sizeof(Max)))
+			{
+				return false;
+			}
+			Val.OutputMax[Key] = Max;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Whether every byte of the buffer has been read.
+	 */
+	bool Done() const
+	{
+		return this->Offset == this->Size;
+	}
+
+private:
+	bool Raw(void *Dst, uint64_t Count)
+	{
+		if (this->Failed || Count > this->Size - this->Offset)
+		{
+			return this->Fail();
+		}
+		std::memcpy(Dst, this->Data + this->Offset, Count);
+		this->Offset += Count;
+		return true;
+	}
+
+	bool Fail()
+	{
+		this->Failed = true;
+		return false;
+	}
+
+	const uint8_t *Data;
+	uint64_t Size;
+	uint64_t Offset = 0;
+	bool Failed = false;
+};
+
+}
+
+#endif
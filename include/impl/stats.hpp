@@ -0,0 +1,126 @@
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+#ifndef DOMAIN_IMPL_STATS_HPP_
+#define DOMAIN_IMPL_STATS_HPP_
+
+/**
+ * @file include/impl/stats.hpp
+ * @brief Per-thread counters of how much work a search has done
+ */
+
+namespace dom::impl
+{
+
+/**
+ * @brief A copy of the counters of one thread.
+ */
+typedef struct ThreadStatsSnapshot
+{
+	/* Number of shadow value computations performed */
+	uint64_t ShadowOps;
+
+	/* Number of times F was sampled */
+	uint64_t Samples;
+
+	/* Number of configurations evaluated */
+	uint64_t Configs;
+
+	/* Nanoseconds spent evaluating, if the search is timing its workers */
+	uint64_t Busy;
+}ThreadStatsSnapshot;
+
+/**
+ * @brief The counters of one worker thread, padded to their own cache line.
+ * @details Each block has exactly one writer, its worker, which updates it after every Eval with plain relaxed stores
+ * (no read-modify-write is needed, since nobody else writes). Any thread may read the counters at any time: each one only
+ * grows, but they may be read partway through an update.
+ * Once the executor has returned from a generation, every update made during it is visible to the coordinator.
+ * @author Brian Schnepp
+ */
+class alignas(64) ThreadStats
+{
+public:
+	ThreadStats() = default;
+	~ThreadStats() = default;
+
+	ThreadStats(const ThreadStats &Other) = delete;
+	ThreadStats &operator=(const ThreadStats &Other) = delete;
+
+	/**
+	 * @brief Counts one evaluated configuration. Only the owning worker may call this.
+	 * @param ShadowOps The number of shadow value computations it took
+	 * @param Samples The number of times F was sampled for it
+	 */
+	void Record(uint64_t ShadowOps, uint64_t Samples)
+	{
+		this->ShadowOps.store(this->ShadowOps.load(std::memory_order_relaxed) + ShadowOps, std::memory_order_relaxed);
+		this->Samples.store(this->Samples.load(std::memory_order_relaxed) + Samples, std::memory_order_relaxed);
+		this->Configs.store(this->Configs.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Counts time spent evaluating. Only the owning worker may call this.
+	 * @param Nanos How long it spent, in nanoseconds
+	 */
+	void AddBusy(uint64_t Nanos)
+	{
+		this->Busy.store(this->Busy.load(std::memory_order_relaxed) + Nanos, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @brief Reads the counters. This may be called from any thread.
+	 */
+	ThreadStatsSnapshot Read() const
+	{
+		ThreadStatsSnapshot RetVal;
+		RetVal.ShadowOps = this->ShadowOps.load(std::memory_order_relaxed);
+		RetVal.Samples = this->Samples.load(std::memory_order_relaxed);
+		RetVal.Configs = this->Configs.load(std::memory_order_relaxed);
+		RetVal.Busy = this->Busy.load(std::memory_order_relaxed);
+		return RetVal;
+	}
+
+	/**
+	 * @brief Sets every counter back to zero. This must not run while the owning worker is running.
+	 */
+	void Reset()
+	{
+		this->ShadowOps.store(0, std::memory_order_relaxed);
+		this->Samples.store(0, std::memory_order_relaxed);
+		this->Configs.store(0, std::memory_order_relaxed);
+		this->Busy.store(0, std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic_uint64_t ShadowOps = 0;
+	std::atomic_uint64_t Samples = 0;
+	std::atomic_uint64_t Configs = 0;
+	std::atomic_uint64_t Busy = 0;
+};
+
+static_assert(sizeof(ThreadStats) % 64 == 0);
+
+/**
+ * @brief Adds up the counters of every thread.
+ * @param Stats The counters of each thread
+ * @return The totals over all of them
+ */
+inline ThreadStatsSnapshot SumStats(const std::vector<ThreadStats> &Stats)
+{
+	ThreadStatsSnapshot RetVal{0, 0, 0, 0};
+	for (const ThreadStats &S : Stats)
+	{
+		ThreadStatsSnapshot Snap = S.Read();
+		RetVal.ShadowOps += Snap.ShadowOps;
+		RetVal.Samples += Snap.Samples;
+		RetVal.Configs += Snap.Configs;
+		RetVal.Busy += Snap.Busy;
+	}
+	return RetVal;
+}
+
+}
+
+#endif
@@ -0,0 +1,348 @@
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+#ifndef DOMAIN_IMPL_TAPE_HPP_
+#define DOMAIN_IMPL_TAPE_HPP_
+
+/**
+ * @file include/impl/tape.hpp
+ * @brief A record of the operations done on Values, for computing derivatives
+ */
+
+namespace dom::impl
+{
+
+/**
+ * @brief A record of every operation done on a Value while the tape is active, on the current thread.
+ * @details Each operation is stored as a node with up to two arguments, along with the partial derivative of its result with
+ * respect to each argument, as evaluated with the shadow values at the time. Node 0 stands for anything which is not
+ * being tracked (such as constants), so operations only on untracked values are not recorded at all.
+ * Derivatives are kept in double precision: they guide the search, and do not need to be exact.
+ *
+ * Comparisons between Values are also noted, since an input which decides a branch can change every output after it.
+ *
+ * Every clear starts a new epoch, which Values keep next to the index of their node (see NodeRef), so a Value computed on an
+ * earlier epoch or on another tape is treated as untracked instead of being linked to an unrelated node.
+ * @author Brian Schnepp
+ */
+class Tape
+{
+public:
+	typedef struct Node
+	{
+		uint32_t Args[2];
+		double Partials[2];
+	}Node;
+
+	Tape()
+	{
+		this->Clear();
+	}
+
+	/**
+	 * @brief Forgets every node.
+	 */
+	void Clear()
+	{
+		this->Stamp = NextEpoch();
+		this->Nodes.clear();
+		this->Nodes.push_back(Node{{0, 0}, {0.0, 0.0}});
+		this->Compared.clear();
+	}
+
+	/**
+	 * @brief Creates a node for an independent variable.
+	 * @return The index of the node
+	 */
+	uint32_t Leaf()
+	{
+		this->Nodes.push_back(Node{{0, 0}, {0.0, 0.0}});
+		return (uint32_t)(this->Nodes.size() - 1);
+	}
+
+	/**
+	 * @brief Records an operation.
+	 * @param Left The node of the first argument
+	 * @param DLeft The partial derivative of the result with respect to the first argument
+	 * @param Right The node of the second argument, or 0 if there is none
+	 * @param DRight The partial derivative of the result with respect to the second argument
+	 * @return The index of the node for the result, or 0 if no argument is tracked
+	 */
+	uint32_t Push(uint32_t Left, double DLeft, uint32_t Right = 0, double DRight = 0.0)
+	{
+		Left = (Left < this->Nodes.size()) ? Left : 0;
+		Right = (Right < this->Nodes.size()) ? Right : 0;
+		if (Left == 0 && Right == 0)
+		{
+			return 0;
+		}
+		this->Nodes.push_back(Node{{Left, Right}, {DLeft, DRight}});
+		return (uint32_t)(this->Nodes.size() - 1);
+	}
+
+	/**
+	 * @brief Records that nodes were compared against each other, such as to decide a branch.
+	 * @param Left The node of the first value compared
+	 * @param Right The node of the second value compared
+	 */
+	void Test(uint32_t Left, uint32_t Right = 0)
+	{
+		if (Left != 0 && Left < this->Nodes.size())
+		{
+			this->Compared.push_back(Left);
+		}
+		if (Right != 0 && Right < this->Nodes.size())
+		{
+			this->Compared.push_back(Right);
+		}
+	}
+
+	/**
+	 * @brief Every node which was used in a comparison, in the order they happened.
+	 */
+	const std::vector<uint32_t> &Tested() const
+	{
+		return this->Compared;
+	}
+
+	/**
+	 * @brief Tells apart this tape, since it was last cleared, from every other tape and every earlier clear.
+	 */
+	uint32_t Epoch() const
+	{
+		return this->Stamp;
+	}
+
+	/**
+	 * @brief The number of nodes recorded, including the untracked node 0.
+	 */
+	uint64_t Size() const
+	{
+		return this->Nodes.size();
+	}
+
+	/**
+	 * @brief Forward mode: the derivative of every node with respect to one node.
+	 * @param Input The node to differentiate with respect to
+	 * @return The derivative of each node, by index
+	 */
+	std::vector<double> Forward(uint32_t Input) const
+	{
+		std::vector<double> Tangents(this->Nodes.size(), 0.0);
+		if (Input == 0 || Input >= this->Nodes.size())
+		{
+			return Tangents;
+		}
+
+		Tangents[Input] = 1.0;
+		for (uint64_t Index = Input + 1; Index < this->Nodes.size(); Index++)
+		{
+			const Node &N = this->Nodes[Index];
+			Tangents[Index] = N.Partials[0] * Tangents[N.Args[0]] + N.Partials[1] * Tangents[N.Args[1]];
+		}
+		return Tangents;
+	}
+
+	/**
+	 * @brief Reverse mode: the derivative of one node with respect to every node.
+	 * @param Output The node to differentiate
+	 * @return The derivative of Output with respect to each node, by index
+	 */
+	std::vector<double> Reverse(uint32_t Output) const
+	{
+		std::vector<double> Adjoints(this->Nodes.size(), 0.0);
+		if (Output == 0 || Output >= this->Nodes.size())
+		{
+			return Adjoints;
+		}
+
+		Adjoints[Output] = 1.0;
+		for (uint64_t Index = Output; Index > 0; Index--)
+		{
+			const Node &N = this->Nodes[Index];
+			double Adj = Adjoints[Index];
+			if (Adj == 0.0)
+			{
+				continue;
+			}
+			Adjoints[N.Args[0]] += N.Partials[0] * Adj;
+			Adjoints[N.Args[1]] += N.Partials[1] * Adj;
+		}
+
+		/* Node 0 collects contributions from anything untracked, which are meaningless. */
+		Adjoints[0] = 0.0;
+		return Adjoints;
+	}
+
+	/**
+	 * @brief Finds every node which some set of nodes was computed from, no matter the value of the derivatives along the way.
+	 * @param Roots The nodes to start from
+	 * @return For each node by index, 1 if some root depends on it (including the roots themselves), or 0 otherwise
+	 */
+	std::vector<uint8_t> Reachable(const std::vector<uint32_t> &Roots) const
+	{
+		std::vector<uint8_t> Seen(this->Nodes.size(), 0);
+		uint64_t Highest = 0;
+		for (uint32_t Root : Roots)
+		{
+			if (Root != 0 && Root < this->Nodes.size())
+			{
+				Seen[Root] = 1;
+				Highest = (Root > Highest) ? Root : Highest;
+			}
+		}
+
+		/* Arguments always come before their results, so one backward pass is enough. */
+		for (uint64_t Index = Highest; Index > 0; Index--)
+		{
+			if (Seen[Index])
+			{
+				Seen[this->Nodes[Index].Args[0]] = 1;
+				Seen[this->Nodes[Index].Args[1]] = 1;
+			}
+		}
+		Seen[0] = 0;
+		return Seen;
+	}
+
+private:
+	static uint32_t NextEpoch()
+	{
+		static std::atomic<uint32_t> Counter{0};
+		uint32_t RetVal = Counter.fetch_add(1, std::memory_order_relaxed) + 1;
+
+		/* 0 is never an epoch, so that a zeroed NodeRef is never mistaken for a live one, even after wrapping around. */
+		return (RetVal == 0) ? Counter.fetch_add(1, std::memory_order_relaxed) + 1 : RetVal;
+	}
+
+	uint32_t Stamp;
+	std::vector<Node> Nodes;
+	std::vector<uint32_t> Compared;
+};
+
+/**
+ * @brief The tape operations on this thread are recorded to, if any.
+ */
+inline Tape *&ActiveTape()
+{
+	thread_local Tape *Active = nullptr;
+	return Active;
+}
+
+/**
+ * @brief Records operations on the current thread to a tape, for as long as it is in scope.
+ */
+class ScopedTape
+{
+public:
+	explicit ScopedTape(Tape &Rec) : Previous(ActiveTape())
+	{
+		ActiveTape() = &Rec;
+	}
+
+	~ScopedTape()
+	{
+		ActiveTape() = this->Previous;
+	}
+
+	ScopedTape(const ScopedTape &Other) = delete;
+	ScopedTape &operator=(const ScopedTape &Other) = delete;
+
+private:
+	Tape *Previous;
+};
+
+#if !defined(DOMAIN_NO_TAPE)
+/**
+ * @brief Where a Value was computed on a tape: the index of its node, and the epoch of the tape at the time.
+ * @details Index 0 is untracked. Without DOMAIN_NO_TAPE, this makes every Value 8 bytes larger than it would otherwise be.
+ */
+typedef struct NodeRef
+{
+	uint32_t Index = 0;
+	uint32_t Epoch = 0;
+}NodeRef;
+#else
+/* Nothing is ever recorded, so Values have no room for a node at all. */
+typedef struct NodeRef
+{
+}NodeRef;
+#endif
+
+/**
+ * @brief The partial derivatives of the result of an operation, with respect to each of its (up to) two arguments.
+ */
+typedef struct Partials
+{
+	double Left;
+	double Right;
+}Partials;
+
+/**
+ * @brief Finds the index of a node on the active tape, if it was recorded there since the tape was last cleared.
+ * @return The index, or 0 if the node is untracked, stale, from another tape, or no tape is active
+ */
+inline uint32_t Index(NodeRef Ref)
+{
+#if !defined(DOMAIN_NO_TAPE)
+	Tape *Rec = ActiveTape();
+	if (Rec != nullptr && Ref.Epoch == Rec->Epoch() && Ref.Index < Rec->Size())
+	{
+		return Ref.Index;
+	}
+#endif
+	return 0;
+}
+
+/**
+ * @brief Records an operation on the active tape, if there is one.
+ * @param Left The node of the first argument
+ * @param Right The node of the second argument, or an empty NodeRef if there is none
+ * @param Derive Only called if recording, as Derive() -> Partials, since the derivatives take some work to evaluate.
+ * @return The node of the result
+ */
+template<typename F>
+inline NodeRef Record(NodeRef Left, NodeRef Right, F Derive)
+{
+#if !defined(DOMAIN_NO_TAPE)
+	if (Tape *Rec = ActiveTape())
+	{
+		Partials D = Derive();
+		uint32_t Result = Rec->Push(Index(Left), D.Left, Index(Right), D.Right);
+		return NodeRef{Result, (Result != 0) ? Rec->Epoch() : 0};
+	}
+#endif
+	return NodeRef{};
+}
+
+/**
+ * @brief Creates a node for an independent variable on the active tape, if there is one.
+ */
+inline NodeRef Leaf()
+{
+#if !defined(DOMAIN_NO_TAPE)
+	if (Tape *Rec = ActiveTape())
+	{
+		return NodeRef{Rec->Leaf(), Rec->Epoch()};
+	}
+#endif
+	return NodeRef{};
+}
+
+/**
+ * @brief Notes a comparison between two nodes on the active tape, if there is one.
+ */
+inline void Compare(NodeRef Left, NodeRef Right)
+{
+#if !defined(DOMAIN_NO_TAPE)
+	if (Tape *Rec = ActiveTape())
+	{
+		Rec->Test(Index(Left), Index(Right));
+	}
+#endif
+}
+
+}
+
+#endif
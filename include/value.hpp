@@ -1,5 +1,7 @@
 #include <hpfloat.hpp>
 
+#include "impl/tape.hpp"
+
 #ifndef VALUE_HPP_
 #define VALUE_HPP_
 
@@ -43,6 +45,7 @@ struct Value
 	Value(T Orig, hpfloat Shadow, uint64_t ShadowOps)
 	{
 		this->OrigVal = Orig;
+		this->Node = impl::NodeRef{};
 		this->Shadow = Shadow;
 		this->ShadowOps = ShadowOps;
 	}
@@ -54,6 +57,7 @@ struct Value
 	Value(const hpfloat &Val)
 	{
 		this->OrigVal = (T)Val;
+		this->Node = impl::NodeRef{};
 		this->Shadow = (hpfloat)Val;
 		this->ShadowOps = 0;
 	}
@@ -62,12 +66,14 @@ struct Value
 	{
 		this->Shadow = std::move(Val);
 		this->OrigVal = (T)this->Shadow;
+		this->Node = impl::NodeRef{};
 		this->ShadowOps = 0;
 	}
 
 	Value(const Value &Other)
 	{
 		this->OrigVal = (T)Other.OrigVal;
+		this->Node = Other.Node;
 		this->Shadow = (hpfloat)Other.Shadow;	
 		this->ShadowOps = Other.ShadowOps;	
 	}
@@ -75,10 +81,12 @@ struct Value
 	Value(Value &&Other)
 	{
 		this->OrigVal = (T)Other.OrigVal;
+		this->Node = Other.Node;
 		this->Shadow = (hpfloat)Other.Shadow;
 		this->ShadowOps = Other.ShadowOps;
 
 		Other.OrigVal = T();
+		Other.Node = impl::NodeRef{};
 		Other.Shadow = dom::hpfloat();
 		Other.ShadowOps = 0;
 	}
@@ -87,32 +95,41 @@ struct Value
 	{
 		T NOrigVal = this->OrigVal + Other.OrigVal;
 		hpfloat NShadow = (hpfloat)this->Shadow + (hpfloat)Other.Shadow;
-		return Value<T>{NOrigVal, NShadow, this->ShadowOps+1};
+		Value<T> RetVal{NOrigVal, NShadow, this->ShadowOps+1};
+		RetVal.Node = impl::Record(this->Node, Other.Node, [&]() { return impl::Partials{1.0, 1.0}; });
+		return RetVal;
 	}
 
 	Value<T> operator-(const Value<T> &Other) const
 	{
 		T NOrigVal = this->OrigVal - Other.OrigVal;
 		hpfloat NShadow = (hpfloat)this->Shadow - (hpfloat)Other.Shadow;
-		return Value<T>{NOrigVal, NShadow, this->ShadowOps+1};
+		Value<T> RetVal{NOrigVal, NShadow, this->ShadowOps+1};
+		RetVal.Node = impl::Record(this->Node, Other.Node, [&]() { return impl::Partials{1.0, -1.0}; });
+		return RetVal;
 	}
 
 	Value<T> operator*(const Value<T> &Other) const
 	{
 		T NOrigVal = this->OrigVal * Other.OrigVal;
 		hpfloat NShadow = (hpfloat)this->Shadow * (hpfloat)Other.Shadow;
-		return Value<T>{NOrigVal, NShadow, this->ShadowOps+1};
+		Value<T> RetVal{NOrigVal, NShadow, this->ShadowOps+1};
+		RetVal.Node = impl::Record(this->Node, Other.Node, [&]() { return impl::Partials{Other.Approx(), this->Approx()}; });
+		return RetVal;
 	}
 
 	Value<T> operator/(const Value<T> &Other) const
 	{
 		T NOrigVal = this->OrigVal / Other.OrigVal;
 		hpfloat NShadow = (hpfloat)this->Shadow / (hpfloat)Other.Shadow;
-		return Value<T>{NOrigVal, NShadow, this->ShadowOps+1};
+		Value<T> RetVal{NOrigVal, NShadow, this->ShadowOps+1};
+		RetVal.Node = impl::Record(this->Node, Other.Node, [&]() { return impl::Partials{1.0 / Other.Approx(), -this->Approx() / (Other.Approx() * Other.Approx())}; });
+		return RetVal;
 	}
 
 	Value<T> &operator+=(const Value<T> &Other)
 	{
+		this->Node = impl::Record(this->Node, Other.Node, [&]() { return impl::Partials{1.0, 1.0}; });
 		this->OrigVal += Other.OrigVal;
 		this->Shadow += (hpfloat)Other.Shadow;
 		this->ShadowOps++;
@@ -121,6 +138,7 @@ struct Value
 
 	Value<T> &operator-=(const Value<T> &Other)
 	{
+		this->Node = impl::Record(this->Node, Other.Node, [&]() { return impl::Partials{1.0, -1.0}; });
 		this->OrigVal -= Other.OrigVal;
 		this->Shadow -= (hpfloat)Other.Shadow;
 		this->ShadowOps++;
@@ -129,6 +147,7 @@ struct Value
 
 	Value<T> &operator*=(const Value<T> &Other)
 	{
+		this->Node = impl::Record(this->Node, Other.Node, [&]() { return impl::Partials{Other.Approx(), this->Approx()}; });
 		this->OrigVal *= Other.OrigVal;
 		this->Shadow *= (hpfloat)Other.Shadow;
 		this->ShadowOps++;
@@ -137,6 +156,7 @@ struct Value
 
 	Value<T> &operator/=(const Value<T> &Other)
 	{
+		this->Node = impl::Record(this->Node, Other.Node, [&]() { return impl::Partials{1.0 / Other.Approx(), -this->Approx() / (Other.Approx() * Other.Approx())}; });
 		this->OrigVal /= Other.OrigVal;
 		this->Shadow /= (hpfloat)Other.Shadow;
 		this->ShadowOps++;
@@ -146,6 +166,7 @@ struct Value
 	Value<T> &operator=(const Value<T> &Other)
 	{
 		this->OrigVal = Other.OrigVal;
+		this->Node = Other.Node;
 		this->Shadow = (hpfloat)Other.Shadow;
 		this->ShadowOps = Other.ShadowOps;
 		return *this;
@@ -153,36 +174,42 @@ struct Value
 
 	bool operator<=(const Value<T> &Other) const
 	{
+		this->Compared(Other);
 		return this->OrigVal <= Other.OrigVal 
 			|| this->Shadow <= Other.Shadow;
 	}
 
 	bool operator>=(const Value<T> &Other) const
 	{
+		this->Compared(Other);
 		return this->OrigVal >= Other.OrigVal 
 			|| this->Shadow >= Other.Shadow;
 	}
 
 	bool operator<(const Value<T> &Other) const
 	{
+		this->Compared(Other);
 		return this->OrigVal < Other.OrigVal 
 			|| this->Shadow < Other.Shadow;
 	}
 
 	bool operator>(const Value<T> &Other) const
 	{
+		this->Compared(Other);
 		return this->OrigVal > Other.OrigVal 
 			|| this->Shadow > Other.Shadow;
 	}
 
 	bool operator==(const Value<T> &Other) const
 	{
+		this->Compared(Other);
 		return this->OrigVal == Other.OrigVal 
 			|| this->Shadow == Other.Shadow;
 	}
 
 	bool operator!=(Value<T> Other) const
 	{
+		this->Compared(Other);
 		return this->OrigVal != Other.OrigVal 
 			&& this->Shadow != Other.Shadow;
 	}
@@ -191,14 +218,18 @@ struct Value
 	{
 		T NOrigVal = +this->OrigVal;
 		hpfloat NShadow = +this->Shadow;
-		return Value<T>{NOrigVal, NShadow, this->ShadowOps+1};
+		Value<T> RetVal{NOrigVal, NShadow, this->ShadowOps+1};
+		RetVal.Node = impl::Record(this->Node, impl::NodeRef{}, [&]() { return impl::Partials{1.0, 0.0}; });
+		return RetVal;
 	}
 
 	Value<T> operator-() const
 	{
 		T NOrigVal = -this->OrigVal;
 		hpfloat NShadow = -this->Shadow;
-		return Value<T>{NOrigVal, NShadow, this->ShadowOps+1};
+		Value<T> RetVal{NOrigVal, NShadow, this->ShadowOps+1};
+		RetVal.Node = impl::Record(this->Node, impl::NodeRef{}, [&]() { return impl::Partials{-1.0, 0.0}; });
+		return RetVal;
 	}
 
 	/**
@@ -250,8 +281,46 @@ struct Value
 		return this->ShadowOps;
 	}
 
+	/**
+	 * @brief Obtains the node of the active tape this Value was computed at, or 0 if it isn't being tracked there.
+	 * @details A Value computed on another tape, or before the active one was last cleared, isn't tracked.
+	 */
+	uint32_t TapeNode() const
+	{
+		return impl::Index(this->Node);
+	}
+
+	/**
+	 * @brief Starts tracking this Value on the active tape, as an independent variable.
+	 * @return The node of the tape this Value is now at, or 0 if no tape is active
+	 */
+	uint32_t Track()
+	{
+		this->Node = impl::Leaf();
+		return impl::Index(this->Node);
+	}
+
 private:
+	/**
+	 * @brief Notes a comparison against another Value on the active tape, if any.
+	 */
+	void Compared(const Value<T> &Other) const
+	{
+		impl::Compare(this->Node, Other.Node);
+	}
+
+	/**
+	 * @brief The shadow value, rounded to a double, for computing derivatives with.
+	 */
+	double Approx() const
+	{
+		return mpfr_get_d(this->Shadow.mpfr_srcptr(), MPFR_RNDN);
+	}
+
 	T OrigVal;
+
+	/* Empty, and taking no room, when built with DOMAIN_NO_TAPE. */
+	[[no_unique_address]] impl::NodeRef Node;
 	hpfloat Shadow;
 	uint64_t ShadowOps;
 };
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+
+# Converts a trace file written by dom::TraceRecorder (see include/domain/trace.hpp) to CSV, one row per generation,
+# oldest first. A new search recorded to the same file starts again from generation 0.
+#
+# Usage: trace-to-csv.py TRACE [OUT.csv]
+# Without OUT.csv, the CSV is written to standard output.
+
+import csv
+import struct
+import sys
+
+HEADER = struct.Struct("=8sIIIIQQ")
+RECORD = struct.Struct("=QQQQQQddQ")
+
+FIELDS = [
+	"time_ns",
+	"generation",
+	"generated",
+	"accepted",
+	"evaluated",
+	"shadow_ops",
+	"local_best",
+	"global_best",
+	"flags",
+]
+
+FROM_INITIAL = 1
+ADOPTED = 2
+
+
+def read_trace(path):
+	with open(path, "rb") as f:
+		data = f.read()
+
+	magic, version, record_size, workers, _, capacity, written = HEADER.unpack_from(data, 0)
+	if magic != b"DOMTRACE" or version != 1:
+		raise ValueError(path + " is not a trace file")
+	if record_size != RECORD.size + (8 * workers):
+		raise ValueError(path + " has records of an unexpected size")
+
+	busy = struct.Struct("=" + ("Q" * workers))
+	count = min(written, capacity)
+	rows = []
+	for index in range(written - count, written):
+		offset = HEADER.size + ((index % capacity) * record_size)
+		row = list(RECORD.unpack_from(data, offset))
+		row += list(busy.unpack_from(data, offset + RECORD.size))
+		rows.append(row)
+	return workers, rows
+
+
+def main():
+	if len(sys.argv) not in (2, 3):
+		sys.stderr.write("Usage: trace-to-csv.py TRACE [OUT.csv]\n")
+		return 1
+
+	workers, rows = read_trace(sys.argv[1])
+	out = open(sys.argv[2], "w", newline="") if len(sys.argv) == 3 else sys.stdout
+	writer = csv.writer(out)
+	writer.writerow(FIELDS + ["from_initial", "adopted"] + ["busy_ns_%d" % tid for tid in range(workers)])
+	for row in rows:
+		flags = row[8]
+		writer.writerow(row[:9] + [int(bool(flags & FROM_INITIAL)), int(bool(flags & ADOPTED))] + row[9:])
+	if out is not sys.stdout:
+		out.close()
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
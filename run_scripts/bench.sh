@@ -0,0 +1,11 @@
+#!/bin/sh
+
+# Runs every stencil kernel in both precisions through bench-stencils, and saves the results to a new file under
+# ~/bgrt_results, without deleting anything already there. FORMAT may be csv (default) or json.
+# Any arguments are passed on, such as --threads 8, --repetitions 5, or --budget 10000000.
+
+FORMAT=${FORMAT:-csv}
+mkdir -p ~/bgrt_results
+
+OUT=~/bgrt_results/stencils-$(date +%Y%m%d-%H%M%S).$FORMAT
+../build/bench-stencils --format $FORMAT --out $OUT "$@" && echo "Results written to $OUT"
@@ -0,0 +1,78 @@
+#include <chrono>
+#include <thread>
+#include <iostream>
+#include <domain.hpp>
+
+#include "check.hpp"
+
+using check::Check;
+
+#define ARR_SIZE (5)
+
+using FType = float;
+using Val = dom::Value<FType>;
+using Var = bgrt::Variable<FType>;
+using Array = std::unordered_map<uint64_t, Val>;
+using Conf = std::unordered_map<uint64_t, Var>;
+
+Array Function(Array &Arr)
+{
+	Array RetVal;
+	RetVal[0] = (((Arr[0] + Arr[1]) + Arr[2]) + Arr[3]) + Arr[4];
+	return RetVal;
+}
+
+/* Polls a search until it has finished at least one generation, or the time runs out. */
+bool WaitForGeneration(const dom::AsyncSearch &Search, std::chrono::seconds Limit)
+{
+	auto Deadline = std::chrono::steady_clock::now() + Limit;
+	while (std::chrono::steady_clock::now() < Deadline)
+	{
+		if (Search.Poll().Generations > 0)
+		{
+			return true;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	return false;
+}
+
+int main()
+{
+	dom::Init();
+	std::cout.precision(17);
+
+	Conf Init;
+	for (int i = 0; i < ARR_SIZE; i++)
+	{
+		Init[i] = Var((dom::hpfloat)-1.0, (dom::hpfloat)1.0);
+	}
+
+	dom::SearchOptions Options;
+	Options.NumThreads = 2;
+
+	/* A scale this large stops splitting after a few generations, so Short finishes on its own. Long would take minutes. */
+	dom::AsyncSearch Short = dom::FindErrorMantissaMultithreadAsync<FType>(Init, Function, 20, 0, (FType)(1 << 20), 5, 50, 0, std::cout, Options);
+	dom::AsyncSearch Long = dom::FindErrorMantissaMultithreadAsync<FType>(Init, Function, 20, 0, 1.0, 5, 50, 0, std::cout, Options);
+
+	Check(WaitForGeneration(Long, std::chrono::seconds(60)), "no progress was published for the long search");
+
+	auto Cancelled = std::chrono::steady_clock::now();
+	Long.Cancel();
+	dom::EvalResults LongRes = Long.Result.get();
+	auto Stopped = std::chrono::steady_clock::now();
+	auto Latency = std::chrono::duration_cast<std::chrono::milliseconds>(Stopped - Cancelled);
+	dom::ProgressSnapshot LongNow = Long.Poll();
+	std::cout << "Long:\t" << LongRes.Err << "\tafter " << LongNow.Generations << " generations, stopped in " << Latency.count() << " ms" << std::endl;
+	Check(LongRes.Err >= 0 && LongRes.Err <= 1.0, "the cancelled search returned an impossible error");
+	Check(Latency <= std::chrono::seconds(30), "the cancelled search took too long to stop");
+
+	/* Cancelling one search must leave the other alone. */
+	dom::EvalResults ShortRes = Short.Result.get();
+	dom::ProgressSnapshot ShortNow = Short.Poll();
+	std::cout << "Short:\t" << ShortRes.Err << "\tafter " << ShortNow.Generations << " generations" << std::endl;
+	Check(ShortRes.Err > 0 && ShortRes.Err <= 1.0, "the other search returned an impossible error");
+	Check(ShortNow.Generations != 0 && ShortNow.WorstError > 0, "the other search published no progress");
+
+	return check::Finish();
+}
@@ -1,83 +1,14 @@
 #include <iostream>
 #include <domain.hpp>
 
-#define ARR_SIZE (7)
+#include "kernels/balanced-7-pt.hpp"
+
+#define ARR_SIZE (kernels::balanced7::Inputs)
 
 using FType = float;
-using Val = dom::Value<float>;
 using Var = bgrt::Variable<float>;
-using Array = std::unordered_map<uint64_t, Val>;
 using Conf = std::unordered_map<uint64_t, Var>;
 
-uint64_t ToLinearAddr(int i, int j, int k)
-{
-	/* Transform into center at [0, 0, 0] */
-	int ti = i-1;
-	int tj = j-1;
-	int tk = k-1;
-
-	/* Use a property of C integers to determine if this is the i-axis being worked on.
-	 * If ti is NOT zero, then it's on that axis. Otherwise, it's the [0, 0, 0] point is none of them are not non-zero.
-	 * Since the original coordinate was transformed from [0, 2] to [-1, 1], just use [0, 2] as the variable index.
-	 */
-	if (ti || (!tj && !tk))
-	{
-		return i;
-	}
-
-	if (tj)
-	{
-		if (tj == 1)
-		{
-			return 3;
-		} 
-		else if (tj == -1)
-		{
-			return 4;
-		}
-	}
-
-	if (tk)
-	{
-		if (tk == 1)
-		{
-			return 5;
-		} 
-		else if (tk == -1)
-		{
-			return 6;
-		}
-	}
-
-	return -1;
-
-}
-
-Array Function(Array &Arr)
-{
-	Array RetVal;
-
-	Val Coeffs[7];
-	for (uint64_t Index = 0; Index < 7; Index++)
-	{
-		Coeffs[Index] = (dom::hpfloat)1.0;
-	}
-	
-	int k = 1;	/* 1 is middle of [0, 2] */
-	int j = 1;
-	int i = 1;
-	
-	int offset = ToLinearAddr(i, j, k);	
-	RetVal[offset] = ((((Coeffs[0] * Arr[ToLinearAddr(i+0,j+0, k+0)])
-				+ (Coeffs[1] * Arr[ToLinearAddr(i+1,j+0,k+0)]))
-				+ ((Coeffs[2] * Arr[ToLinearAddr(i-1,j+0,k+0)])
-				+ (Coeffs[3] * Arr[ToLinearAddr(i+0,j+1,k+0)])))
-				+ (((Coeffs[4] * Arr[ToLinearAddr(i+0,j-1,k+0)])
-				+ (Coeffs[5] * Arr[ToLinearAddr(i+0,j+0,k+1)]))
-				+ (Coeffs[6] * Arr[ToLinearAddr(i+0,j+0,k-1)])));
-	return RetVal;
-}
-
 int main()
 {
 	dom::Init();
@@ -90,7 +21,7 @@ int main()
 	}
 
 	auto Start = std::chrono::high_resolution_clock::now();
-	dom::EvalResults Res = dom::FindErrorMantissaMultithread<float>(Init, Function);
+	dom::EvalResults Res = dom::FindErrorMantissaMultithread<float>(Init, kernels::balanced7::Function<FType>);
 	auto End = std::chrono::high_resolution_clock::now();
 	auto Duration = std::chrono::duration_cast<std::chrono::milliseconds>(End - Start);
 
@@ -0,0 +1,40 @@
+#include <string>
+#include <iostream>
+
+#ifndef TESTS_CHECK_HPP_
+#define TESTS_CHECK_HPP_
+
+/**
+ * @file tests/check.hpp
+ * @brief The checks shared by every test run by ctest: each failed one is printed, and the test fails if any did.
+ */
+
+namespace check
+{
+
+inline int Failures = 0;
+
+/**
+ * @brief Counts a failure, printing what failed, if Cond is false.
+ */
+inline void Check(bool Cond, const std::string &What)
+{
+	if (!Cond)
+	{
+		std::cout << "FAIL: " << What << std::endl;
+		Failures++;
+	}
+}
+
+/**
+ * @brief Prints whether every check passed, and returns the exit code of the test.
+ */
+inline int Finish()
+{
+	std::cout << ((Failures == 0) ? "PASS" : "FAIL") << std::endl;
+	return (Failures == 0) ? 0 : 1;
+}
+
+}
+
+#endif
@@ -0,0 +1,249 @@
+#include <string>
+#include <iostream>
+#include <domain.hpp>
+#include <impl/decompose.hpp>
+
+#include "check.hpp"
+
+using check::Check;
+namespace impl = dom::impl;
+
+using Var = bgrt::Variable<float>;
+using Conf = std::unordered_map<uint64_t, Var>;
+
+/* Whether Inner lies within Outer, on every variable of both. */
+bool Within(const Conf &Inner, const Conf &Outer)
+{
+	if (Inner.size() != Outer.size())
+	{
+		return false;
+	}
+	for (const auto &Pair : Inner)
+	{
+		auto Other = Outer.find(Pair.first);
+		if (Other == Outer.end() || Pair.second.Min().SVal() < Other->second.Min().SVal()
+			|| Pair.second.Max().SVal() > Other->second.Max().SVal())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Same(const Conf &Left, const Conf &Right)
+{
+	return Within(Left, Right) && Within(Right, Left);
+}
+
+/* Whether Left and Right are the two halves of Whole: the same on every variable but one, which they split between them. */
+bool Halves(const Conf &Left, const Conf &Right, const Conf &Whole)
+{
+	if (!Within(Left, Whole) || !Within(Right, Whole))
+	{
+		return false;
+	}
+
+	uint64_t Split = 0;
+	for (const auto &Pair : Whole)
+	{
+		const Var &L = Left.at(Pair.first);
+		const Var &R = Right.at(Pair.first);
+		if (L.Min().SVal() == R.Min().SVal() && L.Max().SVal() == R.Max().SVal())
+		{
+			continue;
+		}
+
+		/* The two meet at one point, and reach both ends of the whole between them. */
+		const Var &Low = (L.Min().SVal() < R.Min().SVal()) ? L : R;
+		const Var &High = (L.Min().SVal() < R.Min().SVal()) ? R : L;
+		if (Low.Max().SVal() != High.Min().SVal() || Low.Min().SVal() != Pair.second.Min().SVal()
+			|| High.Max().SVal() != Pair.second.Max().SVal())
+		{
+			return false;
+		}
+		Split++;
+	}
+	return Split == 1;
+}
+
+/* Whether every variable has a range, with its minimum no larger than its maximum. */
+bool Valid(const Conf &C)
+{
+	for (const auto &Pair : C)
+	{
+		if (Pair.second.Min().SVal() > Pair.second.Max().SVal())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/* The part of Left also in Right, which may not be Valid. */
+Conf Intersect(const Conf &Left, const Conf &Right)
+{
+	Conf RetVal;
+	for (const auto &Pair : Left)
+	{
+		const Var &Other = Right.at(Pair.first);
+		RetVal[Pair.first] = Var((Pair.second.Min().SVal() < Other.Min().SVal()) ? Other.Min() : Pair.second.Min(),
+			(Pair.second.Max().SVal() > Other.Max().SVal()) ? Other.Max() : Pair.second.Max());
+	}
+	return RetVal;
+}
+
+Conf Box(std::initializer_list<std::pair<double, double>> Ranges)
+{
+	Conf RetVal;
+	uint64_t Key = 0;
+	for (const auto &Range : Ranges)
+	{
+		RetVal[Key++] = Var((dom::hpfloat)Range.first, (dom::hpfloat)Range.second);
+	}
+	return RetVal;
+}
+
+/* Refuses any box reaching above Limit on variable 0. */
+struct BelowLimit
+{
+	double Limit;
+
+	bool operator()(const Conf &C) const
+	{
+		return C.at(0).Max().SVal() <= this->Limit;
+	}
+};
+
+/* Halves Base over and over, checking every split keeps what is left of Conf in the half kept, and gives away the rest. */
+template<typename FilterFn>
+void HalveRepeatedly(const std::string &Name, Conf C, Conf Base, const FilterFn &Accept, uint64_t Times)
+{
+	for (uint64_t Step = 0; Step < Times; Step++)
+	{
+		const Conf Whole = Base;
+		const Conf Searched = C;
+		Conf Given;
+		if (!impl::Halve(C, Base, Accept, Given))
+		{
+			Check(false, Name + ": refused to split at step " + std::to_string(Step));
+			return;
+		}
+		Check(Within(C, Base), Name + ": the configuration left the kept half at step " + std::to_string(Step));
+		Check(Valid(C) && Same(C, Intersect(Searched, Base)), Name + ": the configuration lost what it had in the kept half at step "
+			+ std::to_string(Step));
+		Check(Halves(Base, Given, Whole), Name + ": the halves do not split the base at step " + std::to_string(Step));
+		Check(Accept(C) && Accept(Base) && Accept(Given), Name + ": a filtered box was kept at step " + std::to_string(Step));
+	}
+}
+
+void TestHalve()
+{
+	/* Conf in the middle of Base, off to one side, and the whole of it. */
+	HalveRepeatedly("centered", Box({{-0.25, 0.25}, {-0.5, 0.5}, {0.0, 0.0}}), Box({{-1.0, 1.0}, {-1.0, 1.0}, {0.0, 0.0}}),
+		dom::AcceptAll{}, 12);
+	HalveRepeatedly("one side", Box({{0.5, 0.75}, {-1.0, -0.9}}), Box({{-1.0, 1.0}, {-1.0, 1.0}}), dom::AcceptAll{}, 12);
+	HalveRepeatedly("whole", Box({{-1.0, 1.0}, {-4.0, 4.0}}), Box({{-1.0, 1.0}, {-4.0, 4.0}}), dom::AcceptAll{}, 12);
+
+	/* The first split is along variable 0, and one of its halves is refused: nothing changes. */
+	Conf C = Box({{-0.5, 0.5}, {-0.5, 0.5}});
+	Conf Base = Box({{-4.0, 4.0}, {-1.0, 1.0}});
+	const Conf Before = C;
+	const Conf BaseBefore = Base;
+	Conf Given;
+	Check(!impl::Halve(C, Base, BelowLimit{1.0}, Given), "refused upper half: split anyway");
+	Check(Same(C, Before) && Same(Base, BaseBefore), "refused upper half: changed the configuration or base");
+	auto AboveLimit = [](const Conf &Box) { return Box.at(0).Min().SVal() >= -1.0; };
+	Check(!impl::Halve(C, Base, AboveLimit, Given), "refused lower half: split anyway");
+	Check(Same(C, Before) && Same(Base, BaseBefore), "refused lower half: changed the configuration or base");
+
+	/* Nothing to split: every variable is a single point. */
+	C = Box({{0.5, 0.5}, {0.25, 0.25}});
+	Base = C;
+	Check(!impl::Halve(C, Base, dom::AcceptAll{}, Given), "points: split anyway");
+	Check(Same(C, Box({{0.5, 0.5}, {0.25, 0.25}})), "points: changed the configuration");
+
+	/* What is left of Conf in the kept half is refused, so the search goes back to all of that half. */
+	C = Box({{-1.0, 3.0}, {-0.5, 0.5}});
+	Base = Box({{-4.0, 4.0}, {-1.0, 1.0}});
+	auto NotNarrow = [](const Conf &Box) { return (Box.at(0).Max().SVal() - Box.at(0).Min().SVal()) >= 4.0; };
+	Check(impl::Halve(C, Base, NotNarrow, Given), "clipped: refused to split");
+	Check(Same(C, Base), "clipped: did not go back to the kept half");
+	Check(Halves(Base, Given, Box({{-4.0, 4.0}, {-1.0, 1.0}})), "clipped: the halves do not split the base");
+}
+
+/* The volume of a box, over the variables Conf gives any room to. */
+double Volume(const Conf &C, const Conf &Whole)
+{
+	double RetVal = 1.0;
+	for (const auto &Pair : Whole)
+	{
+		if (Pair.second.Max().SVal() > Pair.second.Min().SVal())
+		{
+			const Var &V = C.at(Pair.first);
+			RetVal *= (double)(V.Max().SVal() - V.Min().SVal());
+		}
+	}
+	return RetVal;
+}
+
+/* Whether two boxes share no volume: on some variable, one ends where the other starts. */
+bool Disjoint(const Conf &Left, const Conf &Right, const Conf &Whole)
+{
+	for (const auto &Pair : Whole)
+	{
+		const Var &L = Left.at(Pair.first);
+		const Var &R = Right.at(Pair.first);
+		if (Pair.second.Max().SVal() > Pair.second.Min().SVal()
+			&& (L.Max().SVal() <= R.Min().SVal() || R.Max().SVal() <= L.Min().SVal()))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Decomposes C into Count boxes, checking they are disjoint and cover it, and returns how many there were. */
+uint64_t CheckDecompose(const std::string &Name, const Conf &C, uint64_t Count)
+{
+	std::vector<Conf> Boxes = impl::Decompose(C, Count);
+	double Total = 0.0;
+	for (uint64_t Index = 0; Index < Boxes.size(); Index++)
+	{
+		Check(Valid(Boxes[Index]) && Within(Boxes[Index], C), Name + ": box " + std::to_string(Index) + " is outside the configuration");
+		Total += Volume(Boxes[Index], C);
+		for (uint64_t Other = Index + 1; Other < Boxes.size(); Other++)
+		{
+			Check(Disjoint(Boxes[Index], Boxes[Other], C), Name + ": boxes " + std::to_string(Index) + " and " + std::to_string(Other)
+				+ " overlap");
+		}
+	}
+
+	/* Disjoint boxes within it, with as much volume as all of it, cover it exactly. */
+	Check(Total == Volume(C, C), Name + ": the boxes do not cover the configuration");
+	Check(Boxes.size() <= Count, Name + ": " + std::to_string(Boxes.size()) + " boxes instead of " + std::to_string(Count));
+	return Boxes.size();
+}
+
+void TestDecompose()
+{
+	/* 5 variables, one of them a single point, into 4 boxes for every rank. */
+	const Conf C = Box({{-1.0, 1.0}, {0.0, 4.0}, {0.5, 0.5}, {-3.0, 5.0}, {2.0, 2.5}});
+	for (uint64_t NumP : {1, 2, 3, 5, 16})
+	{
+		const std::string Name = std::to_string(NumP) + " ranks";
+		Check(CheckDecompose(Name, C, 4 * NumP) == 4 * NumP, Name + ": too few boxes");
+	}
+
+	/* Only as many boxes as there is room to split into. */
+	Check(CheckDecompose("points", Box({{0.5, 0.5}, {-2.0, -2.0}}), 8) == 1, "points: split a single point");
+	Check(CheckDecompose("one box", C, 1) == 1, "one box: split anyway");
+}
+
+int main()
+{
+	dom::Init();
+
+	TestHalve();
+	TestDecompose();
+	return check::Finish();
+}
@@ -0,0 +1,160 @@
+#include <cmath>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <domain.hpp>
+
+#include "check.hpp"
+
+/* Every quantile is the midpoint of a bin an eighth of an octave wide, so it should be this close to the true one. */
+static const double Bound = 0.09;
+
+using check::Check;
+
+bool Close(double Estimate, double Exact)
+{
+	return std::abs(Estimate - Exact) <= Bound * std::abs(Exact);
+}
+
+dom::hpfloat Special(bool Nan)
+{
+	dom::hpfloat RetVal;
+	if (Nan)
+	{
+		mpfr_set_nan(RetVal.mpfr_ptr());
+	}
+	else
+	{
+		mpfr_set_inf(RetVal.mpfr_ptr(), 1);
+	}
+	return RetVal;
+}
+
+/* The exact quantile of a list of samples, by the same rank as ErrorStatistics::Quantile. */
+double Exact(std::vector<double> Samples, double Q)
+{
+	std::sort(Samples.begin(), Samples.end());
+	uint64_t Rank = (uint64_t)std::ceil(Q * Samples.size());
+	Rank = (Rank == 0) ? 1 : Rank;
+	return Samples[Rank - 1];
+}
+
+void AllZeros()
+{
+	dom::ErrorStatistics Stats;
+	for (uint64_t Index = 0; Index < 1000; Index++)
+	{
+		Stats.Record(Index % 4, (dom::hpfloat)0.0);
+	}
+	Check(Stats.Count() == 1000, "all zeros: Count");
+	Check(Stats.ZeroCount() == 1000, "all zeros: ZeroCount");
+	Check(Stats.NonFiniteCount() == 0, "all zeros: NonFiniteCount");
+	Check(Stats.P99() == 0.0, "all zeros: P99");
+	Check(Stats.Mean() == 0.0 && Stats.Max() == 0.0, "all zeros: Mean and Max");
+	Check(Stats.Histogram().empty(), "all zeros: Histogram");
+	Check(Stats.OutputMaxima().size() == 4, "all zeros: OutputMaxima");
+}
+
+void SingleSpike()
+{
+	dom::ErrorStatistics Stats;
+	for (uint64_t Index = 0; Index < 999; Index++)
+	{
+		Stats.Record(0, (dom::hpfloat)1e-9);
+	}
+	Stats.Record(1, (dom::hpfloat)1e-3);
+
+	Check(Stats.Count() == 1000, "single spike: Count");
+	Check(Stats.ZeroCount() == 0, "single spike: ZeroCount");
+	Check(Close(Stats.P99(), 1e-9), "single spike: P99 is the floor, not the spike");
+	Check(Close(Stats.Quantile(1.0), 1e-3), "single spike: Quantile(1) is the spike");
+	Check(Stats.Max() == 1e-3, "single spike: Max");
+	Check(Stats.OutputMaxima().at(0) == 1e-9 && Stats.OutputMaxima().at(1) == 1e-3, "single spike: OutputMaxima");
+	Check(Stats.Histogram().size() == 2, "single spike: Histogram");
+}
+
+void GeometricTail()
+{
+	/* Each error is 3 times larger than the last, and half as common, spread over its octave. */
+	dom::ErrorStatistics Stats;
+	std::vector<double> Samples;
+	for (uint64_t Step = 0; Step < 16; Step++)
+	{
+		uint64_t Times = 1ULL << (16 - Step);
+		for (uint64_t Index = 0; Index < Times; Index++)
+		{
+			double Val = 1e-10 * std::pow(3.0, (double)Step) * (1.0 + ((double)Index / Times));
+			Samples.push_back(Val);
+			Stats.Record(Index % 3, (dom::hpfloat)Val);
+		}
+	}
+
+	Check(Stats.Count() == Samples.size(), "geometric tail: Count");
+	Check(Stats.ZeroCount() == 0 && Stats.NonFiniteCount() == 0, "geometric tail: ZeroCount and NonFiniteCount");
+	for (double Q : {0.5, 0.9, 0.99, 0.999})
+	{
+		double Estimate = Stats.Quantile(Q);
+		double Truth = Exact(Samples, Q);
+		std::cout << "Q" << Q << ":\t" << Estimate << "\t(exact " << Truth << ")" << std::endl;
+		Check(Close(Estimate, Truth), "geometric tail: Quantile(" + std::to_string(Q) + ")");
+	}
+	Check(Stats.P99() == Stats.Quantile(0.99), "geometric tail: P99");
+	Check(Stats.Max() == *std::max_element(Samples.begin(), Samples.end()), "geometric tail: Max");
+
+	double Sum = 0.0;
+	for (double Val : Samples)
+	{
+		Sum += Val;
+	}
+	Check(std::abs(Stats.Mean() - (Sum / Samples.size())) <= 1e-12 * Stats.Mean(), "geometric tail: Mean");
+
+	/* Splitting the samples between two collectors and merging them gives the same answer. */
+	dom::ErrorStatistics Left;
+	dom::ErrorStatistics Right;
+	for (uint64_t Index = 0; Index < Samples.size(); Index++)
+	{
+		((Index % 2) ? Left : Right).Record(Index % 3, (dom::hpfloat)Samples[Index]);
+	}
+	Left.Merge(Right);
+	Check(Left.Count() == Stats.Count() && Left.P99() == Stats.P99() && Left.Max() == Stats.Max(), "geometric tail: Merge");
+	Left.Clear();
+	Check(Left.Count() == 0 && Left.P99() == 0.0 && Left.Histogram().empty(), "geometric tail: Clear");
+}
+
+void NonFinite()
+{
+	dom::ErrorStatistics Stats;
+	for (uint64_t Index = 0; Index < 98; Index++)
+	{
+		Stats.Record(0, (dom::hpfloat)1e-6);
+	}
+	Stats.Record(1, Special(false));
+	Stats.Record(2, Special(true));
+
+	Check(Stats.Count() == 100, "non-finite: Count");
+	Check(Stats.NonFiniteCount() == 2, "non-finite: NonFiniteCount");
+	Check(Stats.ZeroCount() == 0, "non-finite: ZeroCount");
+	Check(Close(Stats.P99(), 1e-6) && std::isfinite(Stats.P99()), "non-finite: P99 leaves them out");
+	Check(std::abs(Stats.Mean() - 1e-6) <= 1e-18 && Stats.Max() == 1e-6, "non-finite: Mean and Max leave them out");
+	Check(std::isinf(Stats.OutputMaxima().at(1)) && std::isinf(Stats.OutputMaxima().at(2)), "non-finite: OutputMaxima");
+
+	uint64_t Binned = 0;
+	for (const dom::ErrorBin &Bin : Stats.Histogram())
+	{
+		Binned += Bin.Count;
+	}
+	Check(Binned == 98, "non-finite: Histogram leaves them out");
+}
+
+int main()
+{
+	dom::Init();
+	std::cout.precision(17);
+
+	AllZeros();
+	SingleSpike();
+	GeometricTail();
+	NonFinite();
+
+	return check::Finish();
+}
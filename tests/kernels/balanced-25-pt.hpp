@@ -0,0 +1,70 @@
+#include <cstdint>
+
+#include "kernel.hpp"
+
+#ifndef DOMAIN_TESTS_KERNELS_BALANCED_25_PT_HPP_
+#define DOMAIN_TESTS_KERNELS_BALANCED_25_PT_HPP_
+
+/**
+ * @file tests/kernels/balanced-25-pt.hpp
+ * @brief The 25-point stencil, summed as a balanced tree
+ */
+
+namespace kernels::balanced25
+{
+
+/* The number of inputs the kernel reads */
+constexpr uint64_t Inputs = 25;
+
+inline uint64_t ToLinearAddr(int i, int j)
+{
+	return i + (5 * j);
+}
+
+template<typename T>
+Array<T> Function(Array<T> &Arr)
+{
+	Array<T> RetVal;
+	
+	Val<T> Coeffs[25];
+	for (uint64_t Index = 0; Index < 25; Index++)
+	{
+		Coeffs[Index] = (dom::hpfloat)1.0;
+	}
+	
+	/* 2 is middle of [0, 4] */
+	int j = 2;
+	int i = 2;
+	
+	int offset = ToLinearAddr(i, j);
+	RetVal[offset] = (((((Coeffs[0] * Arr[ToLinearAddr(i - 2, j - 2)])
+			+ (Coeffs[1] * Arr[ToLinearAddr(i - 1, j - 2)]))
+			+ ((Coeffs[2] * Arr[ToLinearAddr(i + 0, j - 2)])
+			+ (Coeffs[3] * Arr[ToLinearAddr(i + 1, j - 2)])))
+			+ (((Coeffs[4] * Arr[ToLinearAddr(i + 2, j - 2)])
+			+ (Coeffs[5] * Arr[ToLinearAddr(i - 2, j - 1)]))
+			+ ((Coeffs[6] * Arr[ToLinearAddr(i - 1, j - 1)])
+			+ (Coeffs[7] * Arr[ToLinearAddr(i + 0, j - 1)]))))
+			+ ((((Coeffs[8] * Arr[ToLinearAddr(i + 1, j - 1)])
+			+ (Coeffs[9] * Arr[ToLinearAddr(i + 2, j - 1)]))
+			+ ((Coeffs[10] * Arr[ToLinearAddr(i - 2, j + 0)])
+			+ (Coeffs[11] * Arr[ToLinearAddr(i - 1, j + 0)])))
+			+ (((Coeffs[12] * Arr[ToLinearAddr(i + 0, j + 0)])
+			+ (Coeffs[13] * Arr[ToLinearAddr(i + 1, j + 0)]))
+			+ ((Coeffs[14] * Arr[ToLinearAddr(i + 2, j + 0)])
+			+ (Coeffs[15] * Arr[ToLinearAddr(i - 2, j + 1)])))))
+			+ (((((Coeffs[16] * Arr[ToLinearAddr(i - 1, j + 1)])
+			+ (Coeffs[17] * Arr[ToLinearAddr(i + 0, j + 1)]))
+			+ ((Coeffs[18] * Arr[ToLinearAddr(i + 1, j + 1)])
+			+ (Coeffs[19] * Arr[ToLinearAddr(i + 2, j + 1)])))
+			+ (((Coeffs[20] * Arr[ToLinearAddr(i - 2, j + 2)])
+			+ (Coeffs[21] * Arr[ToLinearAddr(i - 1, j + 2)]))
+			+ ((Coeffs[22] * Arr[ToLinearAddr(i + 0, j + 2)])
+			+ (Coeffs[23] * Arr[ToLinearAddr(i + 1, j + 2)]))))
+			+ ((Coeffs[24] * Arr[ToLinearAddr(i + 2, j + 2)])));
+	return RetVal;
+}
+
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include <cstdint>
+
+#include "kernel.hpp"
+
+#ifndef DOMAIN_TESTS_KERNELS_BALANCED_POISSON_HPP_
+#define DOMAIN_TESTS_KERNELS_BALANCED_POISSON_HPP_
+
+/**
+ * @file tests/kernels/balanced-poisson.hpp
+ * @brief The Poisson stencil, summed as a balanced tree
+ */
+
+namespace kernels::balancedpoisson
+{
+
+/* The number of inputs the kernel reads */
+constexpr uint64_t Inputs = 9;
+
+inline uint64_t ToLinearAddr(int i, int j, int k)
+{
+	return i + (3 * j) + (9 * k);
+}
+
+template<typename T>
+Array<T> Function(Array<T> &Arr)
+{
+	Array<T> RetVal;
+	
+	/* 1 is middle of [0, 3] */
+	int k = 1;
+	int j = 1;
+	int i = 1;
+	
+	int offset = ToLinearAddr(i, j, k);
+	RetVal[offset] = ((((2.666 * Arr[ToLinearAddr(i, j, k)]
+			- 0.166 * Arr[ToLinearAddr(i, j, k - 1)])
+			- (0.166 * Arr[ToLinearAddr(i, j, k + 1)]
+			+ 0.166 * Arr[ToLinearAddr(i, j - 1, k)]))
+			
+			- ((0.166 * Arr[ToLinearAddr(i, j + 1, k)]
+			+ 0.166 * Arr[ToLinearAddr(i + 1, j, k)])
+			- (0.166 * Arr[ToLinearAddr(i - 1, j, k)]
+			+ 0.0833 * Arr[ToLinearAddr(i, j - 1, k - 1)])))
+			
+			- (((0.0833 * Arr[ToLinearAddr(i, j - 1, k + 1)]
+			+ 0.0833 * Arr[ToLinearAddr(i, j + 1, k - 1)])
+			- (0.0833 * Arr[ToLinearAddr(i, j + 1, k + 1)]
+			+ 0.0833 * Arr[ToLinearAddr(i - 1, j, k - 1)]))
+			
+			- ((0.0833 * Arr[ToLinearAddr(i - 1, j, k + 1)]
+			+ 0.0833 * Arr[ToLinearAddr(i - 1, j - 1, k)])
+			- (0.0833 * Arr[ToLinearAddr(i - 1, j + 1, k)]
+			+ 0.0833 * Arr[ToLinearAddr(i + 1, j, k - 1)]))))
+			
+			- ((0.0833 * Arr[ToLinearAddr(i + 1, j, k + 1)]
+			+ 0.0833 * Arr[ToLinearAddr(i + 1, j - 1, k)])
+			- (0.0833 * Arr[ToLinearAddr(i + 1, j + 1, k)]));
+	return RetVal;
+}
+
+}
+
+#endif
@@ -0,0 +1,27 @@
+#include <cstdint>
+#include <unordered_map>
+
+#include <domain.hpp>
+
+#ifndef DOMAIN_TESTS_KERNELS_KERNEL_HPP_
+#define DOMAIN_TESTS_KERNELS_KERNEL_HPP_
+
+/**
+ * @file tests/kernels/kernel.hpp
+ * @brief What every stencil kernel in tests/kernels/ is written in terms of
+ * @details Each kernel is a template over the precision under test, so that the float and double tests, and
+ * bench-stencils, all run exactly the same code.
+ */
+
+namespace kernels
+{
+
+template<typename T>
+using Val = dom::Value<T>;
+
+template<typename T>
+using Array = std::unordered_map<uint64_t, dom::Value<T>>;
+
+}
+
+#endif
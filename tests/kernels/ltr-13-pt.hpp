@@ -0,0 +1,113 @@
+#include <cstdint>
+
+#include "kernel.hpp"
+
+#ifndef DOMAIN_TESTS_KERNELS_LTR_13_PT_HPP_
+#define DOMAIN_TESTS_KERNELS_LTR_13_PT_HPP_
+
+/**
+ * @file tests/kernels/ltr-13-pt.hpp
+ * @brief The 13-point stencil, summed from left to right
+ */
+
+namespace kernels::ltr13
+{
+
+/* The number of inputs the kernel reads */
+constexpr uint64_t Inputs = 13;
+
+inline uint64_t ToLinearAddr(int i, int j, int k)
+{
+	/* Transform into center at [0, 0, 0] */
+	int ti = i-2;
+	int tj = j-2;
+	int tk = k-2;
+
+	/* Use a property of C integers to determine if this is the i-axis being worked on.
+	 * If ti is NOT zero, then it's on that axis. Otherwise, it's the [0, 0, 0] point is none of them are not non-zero.
+	 * Since the original coordinate was transformed from [0, 2] to [-1, 1], just use [0, 2] as the variable index.
+	 */
+	if (ti || (!tj && !tk))
+	{
+		return i;
+	}
+
+	if (tj)
+	{
+		if (tj == 1)
+		{
+			return 5;
+		} else if (tj == 2)
+		{
+			return 6;
+		} 
+		else if (tj == -1)
+		{
+			return 7;
+		}
+		else if (tj == -2)
+		{
+			return 8;
+		}
+	}
+
+	if (tk)
+	{
+		if (tk == 1)
+		{
+			return 9;
+		}
+		else if (tk == 2)
+		{
+			return 10;
+		} 
+		else if (tk == -1)
+		{
+			return 11;
+		}
+		else if (tk == -2)
+		{
+			return 12;
+		}
+	}
+
+	return -1;
+
+}
+
+template<typename T>
+Array<T> Function(Array<T> &Arr)
+{
+	Array<T> RetVal;
+	
+	Val<T> Coeffs[13];
+	for (uint64_t Index = 0; Index < 13; Index++)
+	{
+		Coeffs[Index] = (dom::hpfloat)1.0;
+	}
+	
+	/* 2 is middle of [0, 4] */
+	int k = 2;
+	int j = 2;
+	int i = 2;
+	
+	int offset = ToLinearAddr(i, j, k);
+	RetVal[offset] = (((((((((((((Coeffs[0] * Arr[ToLinearAddr(i+0,j+0,k+0)])
+				+ (Coeffs[1] * Arr[ToLinearAddr(i+1,j+0,k+0)]))
+				+ (Coeffs[2] * Arr[ToLinearAddr(i-1,j+0,k+0)]))
+				+ (Coeffs[3] * Arr[ToLinearAddr(i+0,j+1,k+0)]))
+				+ (Coeffs[4] * Arr[ToLinearAddr(i+0,j-1,k+0)]))
+				+ (Coeffs[5] * Arr[ToLinearAddr(i+0,j+0,k+1)]))
+				+ (Coeffs[6] * Arr[ToLinearAddr(i+0,j+0,k-1)]))
+				+ (Coeffs[7] * Arr[ToLinearAddr(i+2,j+0,k+0)]))
+				+ (Coeffs[8] * Arr[ToLinearAddr(i-2,j+0,k+0)]))
+				+ (Coeffs[9] * Arr[ToLinearAddr(i+0,j+2,k+0)]))
+				+ (Coeffs[10] * Arr[ToLinearAddr(i+0,j-2,k+0)]))
+				+ (Coeffs[11] * Arr[ToLinearAddr(i+0,j+0,k+2)]))
+				+ (Coeffs[12] * Arr[ToLinearAddr(i+0,j+0,k-2)]));
+	return RetVal;
+}
+
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include <cstdint>
+
+#include "kernel.hpp"
+
+#ifndef DOMAIN_TESTS_KERNELS_LTR_5_PT_HPP_
+#define DOMAIN_TESTS_KERNELS_LTR_5_PT_HPP_
+
+/**
+ * @file tests/kernels/ltr-5-pt.hpp
+ * @brief The 5-point stencil, summed from left to right
+ */
+
+namespace kernels::ltr5
+{
+
+/* The number of inputs the kernel reads */
+constexpr uint64_t Inputs = 5;
+
+inline uint64_t ToLinearAddr(int i, int j)
+{
+	/* The actual array is [0, 1, 2, 3, 4]
+	 * To avoid making unnecessary variables, only 5 will be made.
+	 * The first 3 are conditional on i = 0, 1, 2, and j = 0.
+	 * The remainder are the (0, 1) and (0, -1) cases, at 3 and 4. 
+	 */
+	if (j == 0)
+	{
+		return i;
+	}
+
+	if (j == 1)
+	{
+		return 3;
+	}
+	if (j == 5)
+	{
+		return 4;
+	}
+	return 0;
+}
+
+template<typename T>
+Array<T> Function(Array<T> &Arr)
+{
+	Array<T> RetVal;
+	
+	Val<T> Coeffs[5];
+	for (uint64_t Index = 0; Index < 5; Index++)
+	{
+		Coeffs[Index] = (dom::hpfloat)1.0;
+	}
+	
+	/* 1 is middle of [0, 2] */
+	int j = 1;
+	int i = 1;
+	
+	int offset = ToLinearAddr(i, j);
+	RetVal[offset] = (((((Coeffs[0] * Arr[ToLinearAddr(i+0,j+0)]) 
+		+ (Coeffs[1] * Arr[ToLinearAddr(i+0,j+1)]))
+		+ (Coeffs[2] * Arr[ToLinearAddr(i+0,j-1)]))
+		+ (Coeffs[3] * Arr[ToLinearAddr(i+1,j+0)]))
+		+ (Coeffs[4] * Arr[ToLinearAddr(i-1,j+0)]));
+	return RetVal;
+}
+
+}
+
+#endif
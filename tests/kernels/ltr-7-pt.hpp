@@ -0,0 +1,91 @@
+#include <cstdint>
+
+#include "kernel.hpp"
+
+#ifndef DOMAIN_TESTS_KERNELS_LTR_7_PT_HPP_
+#define DOMAIN_TESTS_KERNELS_LTR_7_PT_HPP_
+
+/**
+ * @file tests/kernels/ltr-7-pt.hpp
+ * @brief The 7-point stencil, summed from left to right
+ */
+
+namespace kernels::ltr7
+{
+
+/* The number of inputs the kernel reads */
+constexpr uint64_t Inputs = 7;
+
+inline uint64_t ToLinearAddr(int i, int j, int k)
+{
+	/* Transform into center at [0, 0, 0] */
+	int ti = i-1;
+	int tj = j-1;
+	int tk = k-1;
+
+	/* Use a property of C integers to determine if this is the i-axis being worked on.
+	 * If ti is NOT zero, then it's on that axis. Otherwise, it's the [0, 0, 0] point is none of them are not non-zero.
+	 * Since the original coordinate was transformed from [0, 2] to [-1, 1], just use [0, 2] as the variable index.
+	 */
+	if (ti || (!tj && !tk))
+	{
+		return i;
+	}
+
+	if (tj)
+	{
+		if (tj == 1)
+		{
+			return 3;
+		} 
+		else if (tj == -1)
+		{
+			return 4;
+		}
+	}
+
+	if (tk)
+	{
+		if (tk == 1)
+		{
+			return 5;
+		} 
+		else if (tk == -1)
+		{
+			return 6;
+		}
+	}
+
+	return -1;
+
+}
+
+template<typename T>
+Array<T> Function(Array<T> &Arr)
+{
+	Array<T> RetVal;
+
+	Val<T> Coeffs[7];
+	for (uint64_t Index = 0; Index < 7; Index++)
+	{
+		Coeffs[Index] = (dom::hpfloat)1.0;
+	}
+	
+	int k = 1;	/* 1 is middle of [0, 2] */
+	int j = 1;
+	int i = 1;
+	
+	int offset = ToLinearAddr(i, j, k);	
+	RetVal[offset] = (((((((Coeffs[0] * Arr[ToLinearAddr(i+0,j+0, k+0)])
+				+ (Coeffs[1] * Arr[ToLinearAddr(i+1,j+0,k+0)]))
+				+ (Coeffs[2] * Arr[ToLinearAddr(i-1,j+0,k+0)]))
+				+ (Coeffs[3] * Arr[ToLinearAddr(i+0,j+1,k+0)]))
+				+ (Coeffs[4] * Arr[ToLinearAddr(i+0,j-1,k+0)]))
+				+ (Coeffs[5] * Arr[ToLinearAddr(i+0,j+0,k+1)]))
+				+ (Coeffs[6] * Arr[ToLinearAddr(i+0,j+0,k-1)]));
+	return RetVal;
+}
+
+}
+
+#endif
@@ -0,0 +1,54 @@
+#include <cstdint>
+
+#include "kernel.hpp"
+
+#ifndef DOMAIN_TESTS_KERNELS_LTR_9_PT_HPP_
+#define DOMAIN_TESTS_KERNELS_LTR_9_PT_HPP_
+
+/**
+ * @file tests/kernels/ltr-9-pt.hpp
+ * @brief The 9-point stencil, summed from left to right
+ */
+
+namespace kernels::ltr9
+{
+
+/* The number of inputs the kernel reads */
+constexpr uint64_t Inputs = 9;
+
+inline uint64_t ToLinearAddr(int i, int j)
+{
+	return i + (3 * j);
+}
+
+template<typename T>
+Array<T> Function(Array<T> &Arr)
+{
+	Array<T> RetVal;
+	
+	Val<T> Coeffs[9];
+	for (uint64_t Index = 0; Index < 9; Index++)
+	{
+		Coeffs[Index] = (dom::hpfloat)1.0;
+	}
+	
+	/* 1 is middle of [0, 2] */
+	int j = 1;
+	int i = 1;
+	
+	int offset = ToLinearAddr(i, j);
+	RetVal[offset] = (((((((((Coeffs[0] * Arr[ToLinearAddr(i+0,j+0)]) 
+		+ (Coeffs[1] * Arr[ToLinearAddr(i+0,j+1)]))
+		+ (Coeffs[2] * Arr[ToLinearAddr(i+0,j-1)]))
+		+ (Coeffs[3] * Arr[ToLinearAddr(i+1,j+1)]))
+		+ (Coeffs[4] * Arr[ToLinearAddr(i+1,j-1)]))
+		+ (Coeffs[5] * Arr[ToLinearAddr(i-1,j+1)]))
+		+ (Coeffs[6] * Arr[ToLinearAddr(i-1,j-1)]))
+		+ (Coeffs[7] * Arr[ToLinearAddr(i+1,j+0)]))
+		+ (Coeffs[8] * Arr[ToLinearAddr(i-1,j+0)]));
+	return RetVal;
+}
+
+}
+
+#endif
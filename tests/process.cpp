@@ -0,0 +1,102 @@
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <iostream>
+#include <unistd.h>
+#include <domain.hpp>
+#include <domain/process.hpp>
+
+#include "check.hpp"
+
+using check::Check;
+
+#define ARR_SIZE (5)
+
+using FType = float;
+using Val = dom::Value<FType>;
+using Var = bgrt::Variable<FType>;
+using Array = std::unordered_map<uint64_t, Val>;
+using Conf = std::unordered_map<uint64_t, Var>;
+
+/* The process running the search, and how many times F has run in this process (or the one it was forked from). */
+static pid_t Searcher = 0;
+static uint64_t Calls = 0;
+
+/* Crashes any worker forked before the search has run F 40 times itself, so only the first workers ever crash. */
+Array Function(Array &Arr)
+{
+	if (++Calls == 40 && getpid() != Searcher)
+	{
+		std::abort();
+	}
+
+	Array RetVal;
+	RetVal[0] = (((Arr[0] + Arr[1]) + Arr[2]) + Arr[3]) + Arr[4];
+	return RetVal;
+}
+
+int main()
+{
+	dom::Init();
+	std::cout.precision(17);
+	Searcher = getpid();
+
+	Conf Init;
+	for (int i = 0; i < ARR_SIZE; i++)
+	{
+		Init[i] = Var((dom::hpfloat)-1.0, (dom::hpfloat)1.0);
+	}
+
+	dom::ProcessExecutor<FType> Exec(2);
+	dom::SearchEngine<FType, dom::ShadowOpBudget, dom::AcceptAll, dom::RandomRestart, dom::ProcessExecutor<FType>> Engine(Function,
+		Exec, dom::ShadowOpBudget{200000}, dom::AcceptAll{}, dom::RandomRestart{5}, 20, 50, 0, std::cout);
+
+	/* Every worker's busy time is measured in its own process, and sent back. */
+	dom::TraceRecorder Trace("process.trace", Exec.Workers());
+	Engine.SetTrace(&Trace);
+	dom::TimelineRecorder Timeline("process.json", Exec.Workers());
+	Check(Engine.SetTimeline(&Timeline), "the timeline was refused");
+
+	for (int Run = 0; Run < 2; Run++)
+	{
+		dom::ErrorStatistics Stats;
+		dom::SearchProgress Progress;
+		dom::SearchOptions Options;
+		Options.Distribution = &Stats;
+		Options.Progress = &Progress;
+
+		const uint64_t LostBefore = Exec.Losses();
+		const std::vector<uint64_t> BusyBefore = Trace.Busy();
+		Timeline.Clear();
+		dom::EvalResults Res = Engine.Run(Init, Options);
+		dom::ProgressSnapshot Now = Progress.Read();
+		std::cout << "Run " << Run << ":\t" << Res.Err << "\tafter " << Now.Generations << " generations, " << Now.Samples
+			<< " samples, " << (Exec.Losses() - LostBefore) << " workers lost" << std::endl;
+
+		Check(Res.Err > 0 && Res.Err <= 1.0, "the search returned an impossible error");
+
+		/* Every sample has one output, wherever it was evaluated, and each one must be counted exactly once. */
+		Check(Now.Samples != 0 && Stats.Count() == Now.Samples, "the distribution counted " + std::to_string(Stats.Count()) + " errors");
+
+		/* Only the workers of the first search crash: the second one forks from a process past the 40th call. */
+		const bool Crashed = (Exec.Losses() - LostBefore) > 0;
+		Check(!Exec.Usable() || Crashed == (Run == 0), std::string("workers were ") + (Crashed ? "" : "not ") + "lost");
+
+		const std::vector<uint64_t> Busy = Trace.Busy();
+		for (uint64_t TID = 0; TID < Busy.size(); TID++)
+		{
+			Check(!Trace.Usable() || Busy[TID] > BusyBefore[TID], "worker " + std::to_string(TID) + " was never busy");
+		}
+	}
+
+	/* Every worker's lane has the batches it evaluated in its own process, in the search where none of them crashed. */
+	std::ifstream In("process.json");
+	const std::string Json((std::istreambuf_iterator<char>(In)), std::istreambuf_iterator<char>());
+	for (uint64_t TID = 0; TID < Exec.Workers(); TID++)
+	{
+		const std::string Span = "{\"name\":\"Eval\",\"ph\":\"X\",\"pid\":0,\"tid\":" + std::to_string(TID) + ",";
+		Check(Json.find(Span) != std::string::npos, "worker " + std::to_string(TID) + " has no spans on the timeline");
+	}
+
+	return check::Finish();
+}
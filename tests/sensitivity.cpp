@@ -0,0 +1,126 @@
+#include <cmath>
+#include <string>
+#include <iostream>
+#include <unordered_set>
+#include <domain.hpp>
+
+#include "check.hpp"
+
+using check::Check;
+
+using FType = float;
+using Val = dom::Value<FType>;
+using Var = bgrt::Variable<FType>;
+using Array = std::unordered_map<uint64_t, Val>;
+using Conf = std::unordered_map<uint64_t, Var>;
+
+/* Every derivative below is exact at the point sampled, up to rounding to a double. */
+static const double Bound = 1e-9;
+
+bool Close(double Estimate, double Exact)
+{
+	return std::abs(Estimate - Exact) <= Bound * std::abs(Exact);
+}
+
+/* Uses every operation on Values with a derivative, and never reads input 3. */
+Array Function(Array &Arr)
+{
+	Array RetVal;
+	RetVal[0] = Arr[0] * Arr[0] * Arr[1] - Arr[2] / Arr[1];
+
+	Val Acc = Arr[0];
+	Acc += Arr[1];
+	Acc *= Arr[2];
+	Acc -= Arr[0];
+	Acc /= Arr[1];
+	RetVal[1] = Acc;
+
+	RetVal[2] = -Arr[0] + (+Arr[2]);
+	RetVal[3] = Arr[1] * Arr[1];
+	return RetVal;
+}
+
+/* A single point, so that every sample is taken at exactly the same place. */
+Var Point(double X)
+{
+	return Var((dom::hpfloat)X, (dom::hpfloat)X);
+}
+
+/* Checks the derivative of output Out with respect to input In against the one worked out by hand. */
+void CheckGradient(const std::string &Name, const dom::SensitivityReport &Report, uint64_t Out, uint64_t In, double Exact)
+{
+	const std::string What = Name + ": d(y" + std::to_string(Out) + ")/d(x" + std::to_string(In) + ")";
+	auto Output = Report.Outputs.find(Out);
+	if (Output == Report.Outputs.end() || Output->second.find(In) == Output->second.end())
+	{
+		Check(false, What + " is missing");
+		return;
+	}
+
+	const dom::InputSensitivity &Sens = Output->second.at(In);
+	std::cout << What << ":\t" << Sens.Gradient << "\t(exact " << Exact << ")" << std::endl;
+	Check(Close(Sens.Gradient, Exact), What);
+	Check(Close(Sens.MaxGradient, std::abs(Exact)), What + ", largest magnitude");
+}
+
+/* At x = (2, 3, 5), by hand. */
+void CheckReport(const std::string &Name, const dom::SensitivityReport &Report)
+{
+	/* y0 = x0^2 x1 - x2 / x1 */
+	CheckGradient(Name, Report, 0, 0, 12.0);
+	CheckGradient(Name, Report, 0, 1, 4.0 + 5.0 / 9.0);
+	CheckGradient(Name, Report, 0, 2, -1.0 / 3.0);
+
+	/* y1 = ((x0 + x1) x2 - x0) / x1 */
+	CheckGradient(Name, Report, 1, 0, 4.0 / 3.0);
+	CheckGradient(Name, Report, 1, 1, -8.0 / 9.0);
+	CheckGradient(Name, Report, 1, 2, 5.0 / 3.0);
+
+	/* y2 = -x0 + x2, and y3 = x1^2 */
+	CheckGradient(Name, Report, 2, 0, -1.0);
+	CheckGradient(Name, Report, 2, 1, 0.0);
+	CheckGradient(Name, Report, 2, 2, 1.0);
+	CheckGradient(Name, Report, 3, 1, 6.0);
+
+	/* y0 = 31 / 3, so a relative change in x0 grows by 12 * 2 / (31 / 3) in y0. */
+	const dom::InputSensitivity &Sens = Report.Outputs.at(0).at(0);
+	Check(Close(Sens.Condition, 72.0 / 31.0), Name + ": condition number of y0 in x0");
+}
+
+/* Input 3 is never read, and every output is computed from exactly the inputs it names. */
+void CheckDependencies(const Conf &Init)
+{
+	dom::DependencyReport Report = dom::Dependencies<FType>(Function, Init, 4);
+	Check(!Report.Used(3) && Report.Unused.size() == 1, "dependencies: input 3 is not the only one unused");
+	Check(Report.Used(0) && Report.Used(1) && Report.Used(2), "dependencies: a used input was reported unused");
+	Check(Report.Branches.empty(), "dependencies: an input was compared");
+	Check(Report.Outputs[0] == std::unordered_set<uint64_t>{0, 1, 2}, "dependencies: inputs of y0");
+	Check(Report.Outputs[2] == std::unordered_set<uint64_t>{0, 2}, "dependencies: inputs of y2");
+	Check(Report.Outputs[3] == std::unordered_set<uint64_t>{1}, "dependencies: inputs of y3");
+}
+
+int main()
+{
+	dom::Init();
+	std::cout.precision(17);
+
+	Conf Init;
+	Init[0] = Point(2.0);
+	Init[1] = Point(3.0);
+	Init[2] = Point(5.0);
+
+	/* More outputs than inputs: one forward sweep per input. */
+	CheckReport("forward", dom::Sensitivity<FType>(Function, Init, 4));
+
+	/* As many inputs as outputs: one reverse sweep per output. */
+	Init[3] = Var((dom::hpfloat)-1.0, (dom::hpfloat)1.0);
+	dom::SensitivityReport Report = dom::Sensitivity<FType>(Function, Init, 4);
+	CheckReport("reverse", Report);
+	for (uint64_t Out = 0; Out < 4; Out++)
+	{
+		CheckGradient("reverse", Report, Out, 3, 0.0);
+	}
+	CheckDependencies(Init);
+
+	return check::Finish();
+}
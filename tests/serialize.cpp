@@ -0,0 +1,235 @@
+#include <cstring>
+#include <vector>
+#include <iostream>
+#include <domain.hpp>
+#include <impl/serialize.hpp>
+
+#include "check.hpp"
+
+using Conf = std::unordered_map<uint64_t, bgrt::Variable<float>>;
+
+using check::Check;
+
+/* Exactly the same number, at exactly the same precision, down to the sign of zero. */
+bool Same(const dom::hpfloat &Left, const dom::hpfloat &Right)
+{
+	mpfr_srcptr L = Left.mpfr_srcptr();
+	mpfr_srcptr R = Right.mpfr_srcptr();
+	if (mpfr_get_prec(L) != mpfr_get_prec(R))
+	{
+		return false;
+	}
+	if (mpfr_nan_p(L) || mpfr_nan_p(R))
+	{
+		return mpfr_nan_p(L) && mpfr_nan_p(R);
+	}
+	return mpfr_equal_p(L, R) && (mpfr_signbit(L) == mpfr_signbit(R));
+}
+
+bool Same(const dom::EvalResults &Left, const dom::EvalResults &Right)
+{
+	return Same(Left.Err, Right.Err) && Same(Left.RelErr, Right.RelErr) && Same(Left.ComputedValue, Right.ComputedValue)
+		&& Same(Left.CorrectValue, Right.CorrectValue) && Left.TotalShadowOps == Right.TotalShadowOps && Left.Samples == Right.Samples;
+}
+
+bool Same(const dom::Value<float> &Left, const dom::Value<float> &Right)
+{
+	float L = Left.Val();
+	float R = Right.Val();
+	return std::memcmp(&L, &R, sizeof(float)) == 0 && Same(Left.SVal(), Right.SVal());
+}
+
+bool Same(const Conf &Left, const Conf &Right)
+{
+	if (Left.size() != Right.size())
+	{
+		return false;
+	}
+	for (const auto &Pair : Left)
+	{
+		auto Other = Right.find(Pair.first);
+		if (Other == Right.end() || !Same(Pair.second.Min(), Other->second.Min()) || !Same(Pair.second.Max(), Other->second.Max()))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/* A number at some precision, set by F(Dst). */
+template<typename F>
+dom::hpfloat Make(mpfr_prec_t Prec, F Set)
+{
+	dom::hpfloat RetVal;
+	mpfr_set_prec(RetVal.mpfr_ptr(), Prec);
+	Set(RetVal.mpfr_ptr());
+	return RetVal;
+}
+
+std::vector<dom::hpfloat> Numbers()
+{
+	std::vector<dom::hpfloat> RetVal;
+	RetVal.push_back(Make(128, [](mpfr_ptr X) { mpfr_set_zero(X, 1); }));
+	RetVal.push_back(Make(128, [](mpfr_ptr X) { mpfr_set_zero(X, -1); }));
+	RetVal.push_back(Make(128, [](mpfr_ptr X) { mpfr_set_inf(X, 1); }));
+	RetVal.push_back(Make(128, [](mpfr_ptr X) { mpfr_set_inf(X, -1); }));
+	RetVal.push_back(Make(128, [](mpfr_ptr X) { mpfr_set_nan(X); }));
+
+	/* The smallest subnormal float and double, and far below either. */
+	RetVal.push_back(Make(128, [](mpfr_ptr X) { mpfr_set_ui_2exp(X, 1, -149, MPFR_RNDN); }));
+	RetVal.push_back(Make(128, [](mpfr_ptr X) { mpfr_set_si_2exp(X, -3, -1075, MPFR_RNDN); }));
+	RetVal.push_back(Make(128, [](mpfr_ptr X) { mpfr_set_ui_2exp(X, 1, -100000, MPFR_RNDN); }));
+	RetVal.push_back(Make(128, [](mpfr_ptr X) { mpfr_set_ui_2exp(X, 7, 100000, MPFR_RNDN); }));
+
+	/* Every bit of the significand in use, at the precision of a double, and at the default shadow precision. */
+	RetVal.push_back(Make(53, [](mpfr_ptr X) { mpfr_const_pi(X, MPFR_RNDN); }));
+	RetVal.push_back(Make(53, [](mpfr_ptr X) { mpfr_const_log2(X, MPFR_RNDN); mpfr_neg(X, X, MPFR_RNDN); }));
+	RetVal.push_back(Make(128, [](mpfr_ptr X) { mpfr_const_pi(X, MPFR_RNDN); mpfr_div_ui(X, X, 3, MPFR_RNDN); }));
+	RetVal.push_back(Make(128, [](mpfr_ptr X) { mpfr_set_d(X, 1.0 / 3.0, MPFR_RNDN); mpfr_nextabove(X); }));
+
+	/* Odd sizes, which don't fill their last limb. */
+	RetVal.push_back(Make(2, [](mpfr_ptr X) { mpfr_set_d(X, -0.75, MPFR_RNDN); }));
+	RetVal.push_back(Make(200, [](mpfr_ptr X) { mpfr_const_euler(X, MPFR_RNDN); }));
+	return RetVal;
+}
+
+dom::EvalResults Results()
+{
+	dom::EvalResults RetVal;
+	RetVal.Err = Make(128, [](mpfr_ptr X) { mpfr_set_ui_2exp(X, 3, -30, MPFR_RNDN); mpfr_nextabove(X); });
+	RetVal.RelErr = Make(128, [](mpfr_ptr X) { mpfr_const_pi(X, MPFR_RNDN); mpfr_mul_2si(X, X, -28, MPFR_RNDN); });
+	RetVal.ComputedValue = Make(128, [](mpfr_ptr X) { mpfr_set_flt(X, 0.1f, MPFR_RNDN); });
+	RetVal.CorrectValue = Make(128, [](mpfr_ptr X) { mpfr_set_ui(X, 1, MPFR_RNDN); mpfr_div_ui(X, X, 10, MPFR_RNDN); });
+	RetVal.TotalShadowOps = 0x0123456789ABCDEFULL;
+	RetVal.Samples = 997;
+	return RetVal;
+}
+
+Conf Configuration()
+{
+	Conf RetVal;
+	RetVal[0] = bgrt::Variable<float>((dom::hpfloat)-1.0, (dom::hpfloat)1.0);
+	RetVal[7] = bgrt::Variable<float>(Make(128, [](mpfr_ptr X) { mpfr_set_ui_2exp(X, 1, -140, MPFR_RNDN); }),
+		Make(128, [](mpfr_ptr X) { mpfr_const_pi(X, MPFR_RNDN); }));
+	RetVal[1ULL << 40] = bgrt::Variable<float>(Make(128, [](mpfr_ptr X) { mpfr_set_zero(X, -1); }),
+		Make(128, [](mpfr_ptr X) { mpfr_set_d(X, 1e30, MPFR_RNDN); }));
+	return RetVal;
+}
+
+/* Writes everything there is to test, in one buffer. */
+std::vector<uint8_t> WriteAll(const std::vector<dom::hpfloat> &Nums, const dom::EvalResults &Res, const Conf &C)
+{
+	dom::impl::Serializer Writer;
+	Writer.Write((uint64_t)Nums.size());
+	for (const dom::hpfloat &Num : Nums)
+	{
+		Writer.Write(Num);
+	}
+	Writer.Write(Res);
+	Writer.Write(C);
+	return Writer.Bytes();
+}
+
+/* Reads everything back, checking each against what was written if Compare is true. */
+bool ReadAll(dom::impl::Deserializer &Reader, const std::vector<dom::hpfloat> &Nums, const dom::EvalResults &Res, const Conf &C,
+	bool Compare)
+{
+	uint64_t Count = 0;
+	if (!Reader.Read(Count))
+	{
+		return false;
+	}
+	Check(!Compare || Count == Nums.size(), "count of numbers");
+	for (uint64_t Index = 0; Index < Count && Index < Nums.size(); Index++)
+	{
+		dom::hpfloat Num;
+		if (!Reader.Read(Num))
+		{
+			return false;
+		}
+		Check(!Compare || Same(Num, Nums[Index]), "number " + std::to_string(Index));
+	}
+
+	dom::EvalResults ResBack;
+	if (!Reader.Read(ResBack))
+	{
+		return false;
+	}
+	Check(!Compare || Same(ResBack, Res), "EvalResults");
+
+	Conf CBack;
+	if (!Reader.Read(CBack))
+	{
+		return false;
+	}
+	Check(!Compare || Same(CBack, C), "configuration");
+	return true;
+}
+
+int main()
+{
+	dom::Init();
+
+	const std::vector<dom::hpfloat> Nums = Numbers();
+	const dom::EvalResults Res = Results();
+	const Conf C = Configuration();
+	const std::vector<uint8_t> Bytes = WriteAll(Nums, Res, C);
+	std::cout << Nums.size() << " numbers, a result, and " << C.size() << " variables in " << Bytes.size() << " bytes" << std::endl;
+
+	dom::impl::Deserializer Whole(Bytes);
+	Check(ReadAll(Whole, Nums, Res, C, true), "reading the whole buffer");
+
+	/* Every shorter buffer ends in the middle of something, and must be refused. */
+	uint64_t Accepted = 0;
+	for (uint64_t Length = 0; Length < Bytes.size(); Length++)
+	{
+		std::vector<uint8_t> Truncated(Bytes.begin(), Bytes.begin() + Length);
+		dom::impl::Deserializer Reader(Truncated);
+		if (ReadAll(Reader, Nums, Res, C, false))
+		{
+			Accepted++;
+		}
+	}
+	Check(Accepted == 0, "truncated buffers read successfully: " + std::to_string(Accepted));
+
+	/* Once a Read fails, every later one does too. */
+	dom::impl::Deserializer Short(Bytes.data(), 3);
+	uint64_t Val = 0;
+	Check(!Short.Read(Val), "reading past the end");
+	Check(!Short.Read(Val), "reading after a failure");
+
+	/* A collector of errors comes back counting exactly the same. */
+	dom::ErrorStatistics Stats;
+	for (const dom::hpfloat &Num : Nums)
+	{
+		Stats.Record(Stats.Count() % 3, Num);
+	}
+	dom::impl::Serializer StatsWriter;
+	StatsWriter.Write(Stats);
+	dom::impl::Deserializer StatsReader(StatsWriter.Bytes());
+	dom::ErrorStatistics StatsBack;
+	StatsBack.Record(9, (dom::hpfloat)1.0);
+	Check(StatsReader.Read(StatsBack) && StatsReader.Done(), "reading an ErrorStatistics");
+	Check(StatsBack.Count() == Stats.Count() && StatsBack.ZeroCount() == Stats.ZeroCount()
+		&& StatsBack.NonFiniteCount() == Stats.NonFiniteCount() && StatsBack.Mean() == Stats.Mean() && StatsBack.Max() == Stats.Max()
+		&& StatsBack.OutputMaxima() == Stats.OutputMaxima(), "ErrorStatistics totals");
+	std::vector<dom::ErrorBin> Bins = Stats.Histogram();
+	std::vector<dom::ErrorBin> BinsBack = StatsBack.Histogram();
+	bool SameBins = Bins.size() == BinsBack.size();
+	for (uint64_t Index = 0; SameBins && Index < Bins.size(); Index++)
+	{
+		SameBins = Bins[Index].Lower == BinsBack[Index].Lower && Bins[Index].Count == BinsBack[Index].Count;
+	}
+	Check(SameBins && !Bins.empty(), "ErrorStatistics histogram");
+
+	/* A kind of hpfloat which doesn't exist is refused. */
+	dom::impl::Serializer Writer;
+	Writer.Write(Nums.back());
+	std::vector<uint8_t> Corrupt = Writer.Bytes();
+	Corrupt[sizeof(int64_t)] = 0x7F;
+	dom::impl::Deserializer Bad(Corrupt);
+	dom::hpfloat Num;
+	Check(!Bad.Read(Num), "reading an invalid kind");
+
+	return check::Finish();
+}